@@ -0,0 +1,206 @@
+#include <hwlib.hpp>
+
+#include "hwspi.hpp"
+#include "due_pin.hpp"
+#include "spi_bus_counter.hpp"
+#include "hwlib_ssd1351_buffered.hpp"
+
+// amount of times every benchmark is run
+constexpr static int runs = 10;
+
+/**
+ * @brief Run a benchmark and print the time and spi traffic of a single run
+ * 
+ * @tparam T 
+ * @param name name of the benchmark
+ * @param word_mode if the bus uses 16 bit transfers
+ * @param counter the counter on the display bus
+ * @param benchmark the function to measure
+ * @return int time of a single run in us
+ */
+template <typename T>
+int run_benchmark(const char *name, const bool word_mode, spi_bus_counter & counter, T benchmark) {
+    // reset the counters of the previous benchmark
+    counter.reset();
+
+    // get the start time
+    const auto start = hwlib::now_us();
+
+    for (int i = 0; i < runs; i++) {
+        benchmark();
+    }
+
+    // wait until the last asynchronous write is done
+    counter.wait();
+
+    // get the time of a single run
+    const int time = int((hwlib::now_us() - start) / runs);
+
+    // a 16 bit transfer writes a word with a single register write
+    const int writes = int(counter.bytes - (word_mode ? counter.words : 0)) / runs;
+
+    hwlib::cout << name << (word_mode ? " 16-bit" : " 8-bit") 
+                << " us: " << time 
+                << " bytes: " << int(counter.bytes / runs) 
+                << " transactions: " << int(counter.transactions / runs) 
+                << " writes: " << writes << "\n";
+
+    return time;
+}
+
+/**
+ * @brief Run a benchmark and print the time of a single run
+ * 
+ * @tparam T 
+ * @param name name of the benchmark
+ * @param bus the bus to wait for
+ * @param benchmark the function to measure
+ */
+template <typename T>
+void run_timed(const char *name, hwspi & bus, T benchmark) {
+    // get the start time
+    const auto start = hwlib::now_us();
+
+    for (int i = 0; i < runs; i++) {
+        benchmark();
+    }
+
+    // wait until the last write is done
+    bus.wait();
+
+    hwlib::cout << name << " us: " << int((hwlib::now_us() - start) / runs) << "\n";
+}
+
+/**
+ * @brief Print the effective pixel rate of a benchmark that writes the whole screen
+ * 
+ * @param divider the divider of the data clock
+ * @param time time of a single run in us
+ */
+void print_rate(const uint8_t divider, const int time) {
+    // amount of pixels in a single run
+    constexpr int pixels = 128 * 128;
+
+    hwlib::cout << "divider: " << int(divider) 
+                << " clock khz: " << (84'000 / divider) 
+                << " kpixels/s: " << (time ? (pixels * 1000) / time : 0) << "\n";
+}
+
+int main() {
+    // kill the watchdog (ATSAM3X8E specific)
+    WDT->WDT_MR = WDT_MR_WDDIS;
+
+    // Update the cpu frequency by sleeping (hwlib thing)
+    hwlib::wait_ms(1);
+
+    // create the reset output
+    auto reset = hwlib::target::pin_out(hwlib::target::pins::d8);
+    
+    // create the data/command output
+    auto dc = hwlib::target::pin_out(hwlib::target::pins::d9);
+    
+    // the chip select is npcs0 on D10 and is driven by the spi hardware. D10
+    // is not used as a gpio, a low gpio would keep the chip select asserted
+    auto cs = hwspi_cs();
+
+    // create the hardware spi bus at 84/5 = 16.8mhz
+    auto bus = hwspi(5);
+
+    // use 84/21 = 4mhz for the init sequence and the commands
+    bus.set_divider(spi_profile::command, 21);
+
+    // count all the traffic to the display
+    auto counter = spi_bus_counter(bus);
+
+    // the runtime driver and the driver that has the bus and the pins bound
+    // at compile time are compared at the end. Every driver resets the
+    // screen when it is created, so create them before the display object
+    // runs the init sequence
+    auto runtime = ssd1351(bus, reset, dc, cs);
+
+    auto direct_reset = due::d8();
+    auto direct_dc = due::d9();
+    auto direct_cs = hwspi_cs();
+    auto direct = ssd1351_t<hwspi, due::d9, hwspi_cs, due::d8>(bus, direct_reset, direct_dc, direct_cs);
+
+    // create the display object from the pins and the counter. This resets
+    // the screen again and runs the init sequence
+    auto display = hwlib_ssd1351_buffered(counter, reset, dc, cs);
+
+    // compare the 8 and 16 bit transfers
+    const bool modes[] = {false, true};
+
+    for (const bool word_mode : modes) {
+        bus.set_word_mode(word_mode);
+
+        // fill the whole screen with a single color
+        run_benchmark("clear", word_mode, counter, [&]{
+            display.clear();
+            display.flush();
+        });
+
+        // send the whole framebuffer
+        run_benchmark("framebuffer", word_mode, counter, [&]{
+            display.fill_rect(hwlib::location(0, 0), hwlib::location(128, 128), color565::gray);
+            display.write(hwlib::location(0, 0), color565::red);
+            display.flush();
+        });
+
+        // fill a single 4x4 cell of the game
+        run_benchmark("cell", word_mode, counter, [&]{
+            display.fill_rect(hwlib::location(64, 64), hwlib::location(4, 4), color565::green);
+            display.flush();
+        });
+    }
+
+    // sweep the data clock to find the fastest divider the screen accepts
+    const uint8_t dividers[] = {21, 12, 8, 6, 5, 4, 3, 2};
+
+    for (const uint8_t divider : dividers) {
+        bus.set_divider(spi_profile::data, divider);
+
+        // fill the whole screen with a single color
+        print_rate(divider, run_benchmark("sweep clear", true, counter, [&]{
+            display.clear();
+            display.flush();
+        }));
+
+        // send the whole framebuffer with a pattern that shows write errors
+        print_rate(divider, run_benchmark("sweep framebuffer", true, counter, [&]{
+            for (int y = 0; y < 128; y++) {
+                display.fill_rect(hwlib::location(0, y), hwlib::location(128, 1), 
+                                  (y & 1) ? color565::gray : color565::blue);
+            }
+
+            display.write(hwlib::location(0, 0), color565::red);
+            display.flush();
+        }));
+
+        // keep the pattern on the screen so corrupted pixels can be spotted
+        hwlib::wait_ms(1000);
+    }
+
+    // go back to the default divider
+    bus.set_divider(spi_profile::data, 5);
+
+    // compare the runtime driver with the direct driver on the initialized
+    // screen
+
+    // a address window for every cell of the game (a command and data toggle 
+    // for every few bytes)
+    run_timed("runtime windows", bus, [&]{
+        for (uint8_t i = 0; i < 128; i += 4) {
+            runtime.fill_rect(i, i, 4, 4, color565::green.value);
+        }
+    });
+
+    run_timed("direct windows", bus, [&]{
+        for (uint8_t i = 0; i < 128; i += 4) {
+            direct.fill_rect(i, i, 4, 4, color565::green.value);
+        }
+    });
+
+    while (true) {
+        // loop until we die
+    }
+}
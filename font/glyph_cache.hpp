@@ -0,0 +1,240 @@
+#ifndef GLYPH_CACHE_HPP
+#define GLYPH_CACHE_HPP
+
+#include <hwlib.hpp>
+#include <stddef.h>
+
+#include "hwlib-font-color-16x16.hpp"
+#include "hwlib_ssd1351.hpp"
+#include "rgb565.hpp"
+
+/**
+ * @brief Cache of the 16x16 font characters in the screen format
+ *
+ * @details A character is converted to pixels once for a fore/background
+ * pair. The converted characters that are used the least recently are
+ * replaced first. Every character is written to the window in a single burst
+ * instead of a write for every pixel.
+ *
+ * @tparam Size amount of characters in the cache (512 bytes each)
+ */
+template <size_t Size>
+class glyph_cache {
+    public:
+        // size of a character in pixels
+        constexpr static uint8_t glyph_size = 16;
+
+    protected:
+        /**
+         * @brief A converted character
+         *
+         */
+        struct entry {
+            // the character and the colors it is converted for
+            char character;
+            uint16_t foreground;
+            uint16_t background;
+
+            // counter of the last use. 0 when the entry is not used yet
+            uint32_t last_use;
+
+            // the pixels high byte first
+            uint8_t data[glyph_size * glyph_size * 2];
+        };
+
+        // the converted characters
+        entry entries[Size];
+
+        // counter that is incremented on every lookup
+        uint32_t uses = 0;
+
+        /**
+         * @brief Convert a character to pixels
+         *
+         * @param item the entry to store the pixels in
+         */
+        static void expand(entry &item) {
+            // use the same characters as hwlib::font_color_16x16 so the text
+            // looks the same
+            const uint8_t *bits = hwlib::font_color_16x16::glyph(item.character);
+
+            for (uint8_t y = 0; y < glyph_size; y++) {
+                for (uint8_t x = 0; x < glyph_size; x++) {
+                    const bool set = hwlib::color_image_16x16::pixel(bits, x, y);
+
+                    const uint16_t color = set ? item.foreground : item.background;
+                    uint8_t *pixel = item.data + ((y * glyph_size + x) * 2);
+
+                    pixel[0] = uint8_t(color >> 8);
+                    pixel[1] = uint8_t(color & 0xFF);
+                }
+            }
+        }
+
+    public:
+        constexpr glyph_cache():
+            entries{}
+        {}
+
+        /**
+         * @brief Get the pixels of a character
+         *
+         * @param character
+         * @param foreground
+         * @param background
+         * @return const uint8_t* 16x16 pixels high byte first
+         */
+        const uint8_t *get(const char character, const rgb565 foreground, const rgb565 background) {
+            uses++;
+
+            entry *oldest = &entries[0];
+
+            for (auto &item : entries) {
+                // check if the character is already converted with these colors
+                if (item.last_use && item.character == character &&
+                    item.foreground == foreground.value && item.background == background.value) {
+                    item.last_use = uses;
+
+                    return item.data;
+                }
+
+                if (item.last_use < oldest->last_use) {
+                    oldest = &item;
+                }
+            }
+
+            // replace the entry that is not used for the longest time
+            oldest->character = character;
+            oldest->foreground = foreground.value;
+            oldest->background = background.value;
+            oldest->last_use = uses;
+
+            expand(*oldest);
+
+            return oldest->data;
+        }
+
+        /**
+         * @brief Write a character to a window in a single burst
+         *
+         * @param window
+         * @param pos top left of the character
+         * @param character
+         * @param foreground
+         * @param background
+         */
+        void write(hwlib_ssd1351 &window, const hwlib::location pos, const char character,
+                   const rgb565 foreground, const rgb565 background) {
+            window.write_rect(pos, hwlib::location(glyph_size, glyph_size),
+                              get(character, foreground, background));
+        }
+};
+
+/**
+ * @brief Ostream that writes the 16x16 font to a window using a glyph cache
+ *
+ * @details Handles the same control characters as hwlib::window_ostream:
+ * '\n' for a new line, '\r' to the start of the line, '\v' to the top left,
+ * '\f' to clear the window and '\t' followed by XXYY to go to column XX and
+ * line YY.
+ *
+ * @tparam Size amount of characters in the cache
+ */
+template <size_t Size>
+class glyph_ostream : public hwlib::ostream {
+    protected:
+        // size of a character in pixels
+        constexpr static uint8_t glyph_size = glyph_cache<Size>::glyph_size;
+
+        // window to write to
+        hwlib_ssd1351 &window;
+
+        // the converted characters
+        glyph_cache<Size> &cache;
+
+        // colors of the text in the screen format
+        rgb565 foreground;
+        rgb565 background;
+
+        // position of the next character
+        hwlib::location cursor;
+
+        // amount of digits of a '\t' position that are not received yet
+        uint8_t position_digits;
+
+        // the column and line of a '\t' position
+        uint8_t position[2];
+
+    public:
+        /**
+         * @brief Construct a new glyph ostream
+         *
+         * @param window the window to write to
+         * @param cache the cache with the converted characters
+         * @param foreground color of the text
+         * @param background color behind the text
+         */
+        glyph_ostream(hwlib_ssd1351 &window, glyph_cache<Size> &cache,
+                      const rgb565 foreground, const rgb565 background):
+            window(window), cache(cache), foreground(foreground), background(background),
+            cursor(0, 0), position_digits(0), position{0, 0}
+        {}
+
+        void putc(char c) override {
+            // handle the digits of a '\t' position
+            if (position_digits) {
+                position_digits--;
+
+                // 2 digits for the column and then 2 digits for the line
+                uint8_t &value = position[position_digits < 2];
+                value = uint8_t(value * 10 + (c - '0'));
+
+                if (!position_digits) {
+                    cursor = hwlib::location(position[0] * glyph_size, position[1] * glyph_size);
+                }
+
+                return;
+            }
+
+            switch (c) {
+                case '\n':
+                    cursor = hwlib::location(0, cursor.y + glyph_size);
+                    return;
+                case '\r':
+                    cursor = hwlib::location(0, cursor.y);
+                    return;
+                case '\v':
+                    cursor = hwlib::location(0, 0);
+                    return;
+                case '\f':
+                    window.clear();
+                    cursor = hwlib::location(0, 0);
+                    return;
+                case '\t':
+                    position_digits = 4;
+                    position[0] = 0;
+                    position[1] = 0;
+                    return;
+                default:
+                    break;
+            }
+
+            // go to the next line when the character does not fit
+            if (cursor.x + glyph_size > hwlib_ssd1351::width) {
+                cursor = hwlib::location(0, cursor.y + glyph_size);
+            }
+
+            // skip the characters below the window
+            if (cursor.y + glyph_size <= hwlib_ssd1351::height) {
+                cache.write(window, cursor, c, foreground, background);
+            }
+
+            cursor = hwlib::location(cursor.x + glyph_size, cursor.y);
+        }
+
+        void flush() override {
+            window.flush();
+        }
+};
+
+#endif
@@ -1,36 +1,29 @@
-#include <cstdlib> 
+#include <cstdlib>
 #include "hwlib-graphics.hpp"
 
 #ifndef HWLIB_FONT_COLOR_16X16_H
 #define HWLIB_FONT_COLOR_16X16_H
 
-namespace hwlib {  
+namespace hwlib {
     /**
      * @brief 16x16 font with a background and foreground color
-     * 
+     *
      */
     class color_image_16x16 : public image {
-        private:   
-            uint8_t *data;
+        private:
+            const uint8_t *data;
 
             hwlib::color foreground;
             hwlib::color background;
 
             color get_implementation( location pos ) const override {
-                auto x = 16 - pos.x;
-                return
-                    (( 
-                        data[ ( 2 * pos.y ) + 1 - ( x / 8 ) ]
-                        & ( 0x01 << ( x % 8 ))
-                    ) == 0 )   
-                        ? background
-                        : foreground;
-            }         
-            
-        public:   
+                return pixel( data, pos.x, pos.y ) ? foreground : background;
+            }
+
+        public:
             /// \brief
-            /// the color image class for the 16x16 font                
-            color_image_16x16(): 
+            /// the color image class for the 16x16 font
+            color_image_16x16():
                 image( location( 16, 16 )),
                 data( nullptr ) ,
                 foreground(hwlib::white),
@@ -38,41 +31,72 @@ namespace hwlib {
             {}
 
             /// \brief
-            /// the color image class for the 16x16 font         
-            color_image_16x16( uint8_t * data, hwlib::color f = hwlib::white, hwlib::color b = hwlib::black ):
+            /// the color image class for the 16x16 font
+            color_image_16x16( const uint8_t * data, hwlib::color f = hwlib::white, hwlib::color b = hwlib::black ):
                 image( location( 16, 16 )),
                 data( data ),
                 foreground(f),
                 background(b)
             {}
+
+            /// \brief
+            /// show another character with the same colors
+            void select( const uint8_t * glyph ){
+                data = glyph;
+            }
+
+            /// \brief
+            /// check if a pixel of a character is the foreground
+            /// \details
+            /// glyph is the data of the character in font_16x16_data
+            static constexpr bool pixel( const uint8_t * glyph, int_fast16_t x, int_fast16_t y ){
+                return (
+                    glyph[ ( 2 * y ) + 1 - (( 16 - x ) / 8 ) ]
+                    & ( 0x01 << (( 16 - x ) % 8 ))
+                ) != 0;
+            }
     };
 
     /**
      * @brief Font class with color
-     * 
+     *
+     * @details The characters are read from font_16x16_data when they are
+     * drawn. The font only stores the colors and a single image that is
+     * pointed to the last requested character, so it does not need a table
+     * in ram or a loop in the constructor.
+     *
      */
     class font_color_16x16 : public font {
-        private:   
-            color_image_16x16 images[ 128 ];
+        private:
+            mutable color_image_16x16 current;
+
+        public:
+            /// \brief
+            /// the 16x16 font with color
+            font_color_16x16( hwlib::color f = hwlib::white, hwlib::color b = hwlib::black ):
+                current( glyph( ' ' ), f, b )
+            {}
 
-        public:   
             /// \brief
-            /// the 16x16 font with color    
-            font_color_16x16( hwlib::color f = hwlib::white, hwlib::color b = hwlib::black ){
-                for( uint_fast8_t i = 0; i < 128; ++i ){
-                    uint_fast8_t c = 
-                        ( i < 32 ) || ( i == 127 )
+            /// get the data of a character in font_16x16_data
+            /// \details
+            /// the control characters and 127 show the first character
+            static constexpr const uint8_t * glyph( char c ){
+                return font_16x16_data + 4 + 32 * (
+                    (( c & 0x7F ) < 32 ) || (( c & 0x7F ) == 127 )
                         ? 0
-                        : i - 32;
-                    images[ i ] = color_image_16x16( font_16x16_data + 4 + ( c * 32 ), f, b);
-                }         
+                        : ( c & 0x7F ) - 32
+                );
             }
 
             /// \brief
             /// the [] operator for the font
+            /// \details
+            /// the returned image shows the character until the next call
             const image & operator[]( char c ) const override {
-                return images[ c & 0x7F ];      
-            }      
+                current.select( glyph( c ));
+                return current;
+            }
     };
 };
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,26 @@
+#ifndef BUTTON_EVENT_HPP
+#define BUTTON_EVENT_HPP
+
+#include <stdint.h>
+
+/**
+ * @brief A debounced change of a button
+ *
+ * @details Shared by the due buttons and the stand-in on a host
+ *
+ */
+struct button_event {
+    // time of the first edge of the change. The cycle counter on the due
+    uint32_t time;
+
+    // the button that changed (bit 0 = D4, bit 1 = D3)
+    uint8_t button;
+
+    // if the button is pressed or released
+    bool pressed;
+
+    // the state of all the buttons after the change (bit 0 = D4, bit 1 = D3)
+    uint8_t state;
+};
+
+#endif
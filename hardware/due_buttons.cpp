@@ -0,0 +1,50 @@
+#include "due_buttons.hpp"
+
+lockfree_queue<button_event, due_buttons::queue_size> due_buttons::queue;
+
+volatile uint8_t due_buttons::state = 0;
+
+uint32_t due_buttons::edge_time = 0;
+
+volatile bool due_buttons::debouncing = false;
+
+due_buttons::due_buttons(const uint32_t debounce_us) {
+    // enable the cycle counter for the time of the events
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+    // the pio needs a clock to read the inputs and to detect edges
+    PMC->PMC_PCER0 = (1 << ID_PIOC) | (1 << ID_TC1);
+
+    // use the buttons as inputs
+    PIOC->PIO_PER = pin_mask;
+    PIOC->PIO_ODR = pin_mask;
+
+    // one shot timer at 84 mhz / 128 that stops when it reaches rc
+    TC0->TC_CHANNEL[1].TC_CCR = TC_CCR_CLKDIS;
+    TC0->TC_CHANNEL[1].TC_CMR = TC_CMR_TCCLKS_TIMER_CLOCK4 | TC_CMR_WAVE | 
+                                TC_CMR_WAVSEL_UP_RC | TC_CMR_CPCSTOP;
+    TC0->TC_CHANNEL[1].TC_RC = uint32_t((uint64_t(debounce_us) * (84'000'000 / 128)) / 1'000'000);
+    TC0->TC_CHANNEL[1].TC_IER = TC_IER_CPCS;
+
+    // start with the current state so a button that is already pressed is 
+    // not seen as a press
+    state = read();
+
+    // clear the old edges and enable the interrupt on both edges
+    (void)PIOC->PIO_ISR;
+    PIOC->PIO_IER = pin_mask;
+
+    NVIC_EnableIRQ(TC1_IRQn);
+    NVIC_EnableIRQ(PIOC_IRQn);
+}
+
+extern "C" void PIOC_Handler() {
+    // handle the edges of the buttons
+    due_buttons::pin_handler();
+}
+
+extern "C" void TC1_Handler() {
+    // handle the end of the debounce time
+    due_buttons::timer_handler();
+}
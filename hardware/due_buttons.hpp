@@ -0,0 +1,206 @@
+#ifndef DUE_BUTTONS_HPP
+#define DUE_BUTTONS_HPP
+
+#include <stdint.h>
+#include <atmel\sam3xa\include\sam3xa.h>
+
+#include "lockfree_queue.hpp"
+#include "button_event.hpp"
+
+/**
+ * @brief Interrupt driven buttons on D4 and D3
+ *
+ * @details A edge on a button disables the interrupts of the buttons and
+ * starts a hardware timer (TC0 channel 1). When the timer ends the buttons
+ * are sampled and every button that has a different level than before is
+ * added to a queue with the time of the first edge. The main loop only needs
+ * to read the queue.
+ *
+ */
+class due_buttons {
+    protected:
+        // amount of events in the queue
+        constexpr static size_t queue_size = 8;
+
+        // pins of the buttons on pioc (bit 0 = D4, bit 1 = D3)
+        constexpr static uint32_t pins[] = {PIO_PC26, PIO_PC28};
+
+        // mask of all the button pins
+        constexpr static uint32_t pin_mask = PIO_PC26 | PIO_PC28;
+
+        // the debounced changes that are not read yet
+        static lockfree_queue<button_event, queue_size> queue;
+
+        // the debounced state of the buttons
+        static volatile uint8_t state;
+
+        // cycle counter of the first edge that is being debounced
+        static uint32_t edge_time;
+
+        // if a edge is being debounced
+        static volatile bool debouncing;
+
+        /**
+         * @brief Read the level of the buttons
+         *
+         * @return uint8_t bit 0 = D4, bit 1 = D3
+         */
+        static uint8_t read() {
+            const uint32_t level = PIOC->PIO_PDSR;
+            uint8_t result = 0;
+
+            for (uint8_t i = 0; i < 2; i++) {
+                if (level & pins[i]) {
+                    result |= (1 << i);
+                }
+            }
+
+            return result;
+        }
+
+        /**
+         * @brief Ignore the buttons and start the debounce timer
+         *
+         */
+        static void start_debounce() {
+            // ignore the bouncing edges until the timer ends
+            PIOC->PIO_IDR = pin_mask;
+
+            edge_time = DWT->CYCCNT;
+            debouncing = true;
+
+            // start the debounce timer
+            TC0->TC_CHANNEL[1].TC_CCR = TC_CCR_CLKEN | TC_CCR_SWTRG;
+        }
+
+    public:
+        /**
+         * @brief Construct a new due buttons object
+         *
+         * @param debounce_us time the buttons need to be stable
+         */
+        due_buttons(const uint32_t debounce_us = 5'000);
+
+        /**
+         * @brief Get the next button change
+         *
+         * @param event the change. Only valid when true is returned
+         * @return true when there was a change
+         * @return false when the queue is empty
+         */
+        bool pop(button_event &event) {
+            const button_event *front = queue.front();
+
+            if (!front) {
+                return false;
+            }
+
+            event = *front;
+            queue.pop();
+
+            return true;
+        }
+
+        /**
+         * @brief Get the next button change without removing it
+         *
+         * @return const button_event* nullptr when there is no change
+         */
+        const button_event *peek() const {
+            return queue.front();
+        }
+
+        /**
+         * @brief Remove all the changes that are not read yet
+         *
+         */
+        void clear() {
+            while (queue.front()) {
+                queue.pop();
+            }
+        }
+
+        /**
+         * @brief Get the debounced state of the buttons
+         *
+         * @return uint8_t bit 0 = D4, bit 1 = D3
+         */
+        uint8_t get() const {
+            return state;
+        }
+
+        /**
+         * @brief Sleep until a condition is true
+         *
+         * @details The condition is checked again after every interrupt. The
+         * interrupts are masked between the check and the sleep, so a change
+         * of the buttons can not get lost between them. A pending interrupt
+         * still wakes the core from WFI
+         *
+         * @tparam F
+         * @param condition function that returns true to stop sleeping
+         */
+        template <typename F>
+        static void sleep_until(F condition) {
+            __disable_irq();
+
+            while (!condition()) {
+                __WFI();
+
+                // let the interrupt that woke us run
+                __enable_irq();
+                __disable_irq();
+            }
+
+            __enable_irq();
+        }
+
+        /**
+         * @brief Interrupt handler for a edge on the buttons
+         *
+         */
+        static void pin_handler() {
+            // reading the status clears the interrupts
+            const uint32_t status = PIOC->PIO_ISR & pin_mask;
+
+            if (!status || debouncing) {
+                return;
+            }
+
+            start_debounce();
+        }
+
+        /**
+         * @brief Interrupt handler for the end of the debounce timer
+         *
+         */
+        static void timer_handler() {
+            // reading the status clears the interrupt
+            (void)TC0->TC_CHANNEL[1].TC_SR;
+
+            // add a event for every button that changed
+            const uint8_t level = read();
+            const uint8_t changed = level ^ state;
+
+            for (uint8_t i = 0; i < 2; i++) {
+                if (changed & (1 << i)) {
+                    // drop the event when the main loop does not read the queue
+                    queue.push({edge_time, uint8_t(1 << i), bool(level & (1 << i)), level});
+                }
+            }
+
+            state = level;
+            debouncing = false;
+
+            // clear the edges we ignored and listen to the buttons again
+            (void)PIOC->PIO_ISR;
+            PIOC->PIO_IER = pin_mask;
+
+            // a button can change between the sample and enabling the interrupt
+            if (read() != state) {
+                start_debounce();
+            }
+        }
+};
+
+#endif
@@ -0,0 +1,81 @@
+#ifndef DUE_PIN_HPP
+#define DUE_PIN_HPP
+
+#include <hwlib.hpp>
+#include <atmel\sam3xa\include\sam3xa.h>
+
+/**
+ * @brief Due output pin that is known at compile time
+ * 
+ * @details Setting the pin is a single store to the set or clear register of 
+ * the port. The class is final so a call on the pin type is not virtual and 
+ * can be inlined.
+ * 
+ * @tparam Port base address of the pio controller of the pin
+ * @tparam Mask mask of the pin in the pio controller
+ */
+template <uint32_t Port, uint32_t Mask>
+class due_pin_out final : public hwlib::pin_out {
+    protected:
+        /**
+         * @brief Get the pio controller of the pin
+         * 
+         * @return Pio* 
+         */
+        static Pio *port() {
+            return reinterpret_cast<Pio*>(Port);
+        }
+
+    public:
+        /**
+         * @brief Construct a new due pin out object
+         * 
+         * @details Gives the pin to the pio controller and enables the output
+         * 
+         */
+        due_pin_out() {
+            port()->PIO_PER = Mask;
+            port()->PIO_OER = Mask;
+        }
+
+        /**
+         * @brief Set the pin without a object
+         * 
+         * @param value 
+         */
+        static void write(const bool value) {
+            if (value) {
+                port()->PIO_SODR = Mask;
+            }
+            else {
+                port()->PIO_CODR = Mask;
+            }
+        }
+
+        /**
+         * @brief Set the pin
+         * 
+         * @param value 
+         * @param buf 
+         */
+        void set(bool value, hwlib::buffering buf = hwlib::buffering::unbuffered) override {
+            write(value);
+        }
+};
+
+/**
+ * @brief The due pins used by the screen
+ * 
+ */
+namespace due {
+    // base address of the pio controller of the pins
+    constexpr uint32_t pioc = 0x400E1200;
+
+    // reset pin of the screen
+    using d8 = due_pin_out<pioc, (1u << 22)>;
+
+    // data/command pin of the screen
+    using d9 = due_pin_out<pioc, (1u << 21)>;
+}
+
+#endif
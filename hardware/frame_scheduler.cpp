@@ -0,0 +1,97 @@
+#include "frame_scheduler.hpp"
+
+frame_scheduler::frame_scheduler(const uint32_t period_us):
+    period(period_us * ticks_per_us)
+{
+    // the timer needs a clock to count
+    PMC->PMC_PCER0 = (1 << ID_TC0);
+
+    // free running timer at 84 mhz / 2 that wraps at 2^32
+    TC0->TC_CHANNEL[0].TC_CCR = TC_CCR_CLKDIS;
+    TC0->TC_CHANNEL[0].TC_CMR = TC_CMR_TCCLKS_TIMER_CLOCK1 | TC_CMR_WAVE |
+                                TC_CMR_WAVSEL_UP;
+
+    // only interrupt on a deadline while we are sleeping
+    TC0->TC_CHANNEL[0].TC_IDR = 0xFFFFFFFF;
+    TC0->TC_CHANNEL[0].TC_CCR = TC_CCR_CLKEN | TC_CCR_SWTRG;
+
+    NVIC_EnableIRQ(TC0_IRQn);
+
+    start();
+}
+
+void frame_scheduler::start() {
+    deadline = now();
+    frame_start = deadline;
+    logic_end = deadline;
+
+    stats = {};
+}
+
+void frame_scheduler::wait() {
+    // the next deadline is relative to the last deadline and not to the
+    // time the frame ended
+    deadline += period;
+
+    // time the frame starts after its deadline when the last frame overran
+    uint32_t late = 0;
+
+    if (passed(deadline)) {
+        // the last frame took longer than a period. Keep how late this frame
+        // is and restart the deadlines from now
+        late = now() - deadline;
+
+        stats.overruns++;
+        deadline = now();
+    }
+    else {
+        sleep_until(deadline);
+    }
+
+    const uint32_t start = now();
+
+    interval = start - frame_start;
+    frame_start = start;
+    logic_end = frame_start;
+
+    // store how late we woke up. Includes the time a overrun was late
+    const uint32_t jitter = (frame_start - deadline) + late;
+
+    stats.frames++;
+    stats.jitter_total += jitter;
+
+    if (jitter > stats.jitter_max) {
+        stats.jitter_max = jitter;
+    }
+}
+
+void frame_scheduler::sleep_until(const uint32_t time) {
+    // interrupt when the timer reaches the deadline
+    TC0->TC_CHANNEL[0].TC_RA = time;
+    (void)TC0->TC_CHANNEL[0].TC_SR;
+    TC0->TC_CHANNEL[0].TC_IER = TC_IER_CPAS;
+
+    // mask the interrupts so one can not fire between the check and the
+    // sleep. A pending interrupt still wakes the core from WFI
+    __disable_irq();
+
+    // the compare only triggers when the timer is equal to the deadline.
+    // Checking the time also covers a deadline that passed before the
+    // interrupt was enabled
+    while (!passed(time)) {
+        __WFI();
+
+        // let the interrupt that woke us run
+        __enable_irq();
+        __disable_irq();
+    }
+
+    __enable_irq();
+
+    TC0->TC_CHANNEL[0].TC_IDR = TC_IDR_CPAS;
+}
+
+extern "C" void TC0_Handler() {
+    // wake the main loop on a deadline
+    frame_scheduler::timer_handler();
+}
@@ -0,0 +1,182 @@
+#ifndef FRAME_SCHEDULER_HPP
+#define FRAME_SCHEDULER_HPP
+
+#include <stdint.h>
+#include <atmel\sam3xa\include\sam3xa.h>
+
+#include "frame_stats.hpp"
+
+/**
+ * @brief Starts frames on absolute deadlines and sleeps in between
+ *
+ * @details TC0 channel 0 counts up at 84 mhz / 2 without resetting. Every
+ * deadline is one period after the previous deadline so the frame rate does
+ * not drift with the time a frame takes. While waiting the core sleeps until
+ * the compare interrupt of the deadline. The button interrupts also wake the
+ * core so their events are queued right away, after which it sleeps again.
+ *
+ */
+class frame_scheduler {
+    protected:
+        // ticks of the timer in a us (84 mhz / 2)
+        constexpr static uint32_t ticks_per_us = 42;
+
+        // time between the deadlines in ticks
+        uint32_t period;
+
+        // time the current frame should have started
+        uint32_t deadline = 0;
+
+        // time the current frame started
+        uint32_t frame_start = 0;
+
+        // time between the start of the last two frames
+        uint32_t interval = 0;
+
+        // time from the start to the end of drawing of the last frame
+        uint32_t frame_time = 0;
+
+        // time the game logic of the current frame ended
+        uint32_t logic_end = 0;
+
+        // timing of the frames
+        frame_stats stats = {};
+
+        /**
+         * @brief Get the current time
+         *
+         * @return uint32_t time in ticks
+         */
+        static uint32_t now() {
+            return TC0->TC_CHANNEL[0].TC_CV;
+        }
+
+        /**
+         * @brief Check if a time has passed. Works when the timer wraps
+         *
+         * @param time
+         * @return true
+         * @return false
+         */
+        static bool passed(const uint32_t time) {
+            return int32_t(now() - time) >= 0;
+        }
+
+        /**
+         * @brief Sleep until a time has passed
+         *
+         * @param time
+         */
+        static void sleep_until(const uint32_t time);
+
+    public:
+        /**
+         * @brief Construct a new frame scheduler object
+         *
+         * @param period_us time between the start of two frames
+         */
+        frame_scheduler(const uint32_t period_us);
+
+        /**
+         * @brief Start the deadlines from the current time
+         *
+         * @details Also resets the statistics. The first frame starts one
+         * period after this call.
+         *
+         */
+        void start();
+
+        /**
+         * @brief Sleep until the deadline of the next frame and start it
+         *
+         * @details When the deadline has already passed the frame starts
+         * right away and the deadlines restart from now. The missed frames are
+         * not run back to back. The time the frame is late is added to the
+         * jitter.
+         *
+         */
+        void wait();
+
+        /**
+         * @brief Mark the end of the game logic of the current frame
+         *
+         */
+        void logic_done() {
+            logic_end = now();
+
+            const uint32_t time = logic_end - frame_start;
+
+            stats.logic_total += time;
+
+            if (time > stats.logic_max) {
+                stats.logic_max = time;
+            }
+        }
+
+        /**
+         * @brief Mark the end of drawing the current frame
+         *
+         */
+        void render_done() {
+            const uint32_t end = now();
+            const uint32_t time = end - logic_end;
+
+            frame_time = end - frame_start;
+
+            stats.render_total += time;
+
+            if (time > stats.render_max) {
+                stats.render_max = time;
+            }
+        }
+
+        /**
+         * @brief Get the timing of the frames
+         *
+         * @return const frame_stats&
+         */
+        const frame_stats &get_stats() const {
+            return stats;
+        }
+
+        /**
+         * @brief Get the time between the start of the last two frames
+         *
+         * @return uint32_t
+         */
+        uint32_t get_interval() const {
+            return interval;
+        }
+
+        /**
+         * @brief Get the time from the start to the end of drawing of the
+         * last frame
+         *
+         * @return uint32_t
+         */
+        uint32_t get_frame_time() const {
+            return frame_time;
+        }
+
+        /**
+         * @brief Convert timer ticks to us
+         *
+         * @param ticks
+         * @return uint32_t
+         */
+        constexpr static uint32_t to_us(const uint64_t ticks) {
+            return uint32_t(ticks / ticks_per_us);
+        }
+
+        /**
+         * @brief Interrupt handler for the compare of a deadline
+         *
+         */
+        static void timer_handler() {
+            // reading the status clears the interrupt. The main loop checks
+            // the time itself so we only need to wake it
+            (void)TC0->TC_CHANNEL[0].TC_SR;
+        }
+};
+
+#endif
@@ -0,0 +1,34 @@
+#ifndef FRAME_STATS_HPP
+#define FRAME_STATS_HPP
+
+#include <stdint.h>
+
+/**
+ * @brief Timing of the frames since the last reset of the statistics
+ *
+ * @details Shared by the frame scheduler of the due and the stand-in on a
+ * host. The times are in the ticks of the scheduler (timer ticks on the due,
+ * ns on a host). Use frame_scheduler::to_us to convert them.
+ *
+ */
+struct frame_stats {
+    // amount of frames that are started
+    uint32_t frames;
+
+    // amount of frames that started after the deadline of the next frame
+    uint32_t overruns;
+
+    // time between the deadline and the start of a frame
+    uint32_t jitter_max;
+    uint64_t jitter_total;
+
+    // time spent in the game logic of a frame
+    uint32_t logic_max;
+    uint64_t logic_total;
+
+    // time spent drawing a frame
+    uint32_t render_max;
+    uint64_t render_total;
+};
+
+#endif
@@ -0,0 +1,9 @@
+#include "hwspi.hpp"
+
+// the transfers of SPI0
+template class spi_pdc<spi0_registers>;
+
+extern "C" void SPI0_Handler() {
+    // handle the asynchronous writes
+    hwspi::interrupt_handler();
+}
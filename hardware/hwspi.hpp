@@ -5,15 +5,45 @@
 #include <atmel\sam3xa\include\sam3xa.h>
 
 #include "variant.h"
+#include "spi_bus_extended.hpp"
+#include "spi_registers.hpp"
+#include "spi_pdc.hpp"
+
+// the transfers of SPI0 are instantiated in hwspi.cpp
+extern template class spi_pdc<spi0_registers>;
+
+/**
+ * @brief Chip select of the hardware spi
+ * 
+ * @details The chip select is driven by the spi hardware (npcs0 on D10) so 
+ * setting the pin does nothing. Use this as the chip select of a device on 
+ * the hardware spi instead of a gpio pin on D10. D10 is connected to the 
+ * npcs0 pin, so a gpio that drives it low keeps the chip select asserted
+ * 
+ */
+class hwspi_cs final : public hwlib::pin_out {
+    public:
+        void set(bool value, hwlib::buffering buf = hwlib::buffering::unbuffered) override {
+            // npcs0 is controlled by the spi hardware
+        }
+};
 
 /**
  * @brief Due hardware spi library
  * 
- * @details Library for writing directly to the sam3x8e hardware spi
+ * @details Library for writing directly to the sam3x8e hardware spi. The class
+ * is final so calls on a hwspi (like from ssd1351_t) are not virtual. The 
+ * transfers and the pdc are handled by spi_pdc.
  * 
  */
-class hwspi : public hwlib::spi_bus {
+class hwspi final : public spi_bus_extended {
 	protected:
+        // the transfers of the first hardware spi
+        using pdc = spi_pdc<spi0_registers>;
+
+        // if 16 bit transfers are used for the 16 bit writes
+        bool word_mode;
+
         /**
          * @brief Configure a gpio pin for spi usage
          * 
@@ -68,8 +98,17 @@ class hwspi : public hwlib::spi_bus {
             reset();
 
             // set spi configuration parameters.
-            SPI0->SPI_MR = SPI_MR_MSTR | SPI_MR_PS | SPI_MR_MODFDIS | loopback << 7;
-            SPI0->SPI_CSR[0] = SPI_MODE0 | SPI_CSR_SCBR(divider) | SPI_CSR_DLYBCT(1);
+            // uses a fixed peripheral select (npcs0) so the pdc can transfer bytes
+            SPI0->SPI_MR = SPI_MR_MSTR | SPI_MR_MODFDIS | SPI_PCS(0) | loopback << 7;
+            // keep the chip select asserted between transfers until the end of a 
+            // batch. No delay is needed between the transfers
+            SPI0->SPI_CSR[0] = SPI_MODE0 | SPI_CSR_SCBR(divider) | SPI_CSR_CSAAT | SPI_CSR_DLYBCT(0);
+
+            // make sure the pdc is not running
+            SPI0->SPI_PTCR = PERIPH_PTCR_TXTDIS | PERIPH_PTCR_RXTDIS;
+
+            // enable the interrupt for the asynchronous writes
+            NVIC_EnableIRQ(SPI0_IRQn);
 
             // enable the spi hardware
             enable(true);
@@ -106,18 +145,7 @@ class hwspi : public hwlib::spi_bus {
          * @details might wait until enough clock cycles have been send
          */
         void write(const uint8_t data) {
-            // wait until the tx buffer is empty
-            while ((SPI0->SPI_SR & SPI_SR_TXEMPTY) == 0) {
-                // wait until we can write data
-            }
-
-            // write the data
-            SPI0->SPI_TDR = data | SPI_PCS(0);
-
-            // wait until the data is written
-            while ((SPI0->SPI_SR & SPI_SR_TDRE) == 0) {
-                // wait until the write is done
-            }
+            pdc::write(data);
         }
 
         /**
@@ -126,12 +154,7 @@ class hwspi : public hwlib::spi_bus {
          * @details might wait until enough clock cycles have been send
          */
         uint8_t read() {
-            while ((SPI0->SPI_SR & SPI_SR_RDRF) == 0) {
-                // wait until data is ready
-            }
-
-            // return the last byte from the register
-            return SPI0->SPI_RDR & 0xFF;
+            return pdc::read();
         }
 
         /**
@@ -149,22 +172,61 @@ class hwspi : public hwlib::spi_bus {
         }
 
 	public:
+        /**
+         * @brief Interrupt handler for the asynchronous writes
+         * 
+         * @details Called from the SPI0 interrupt
+         * 
+         */
+        static void interrupt_handler() {
+            pdc::interrupt_handler();
+        }
+
 		/**
 		 * @brief Hardware spi constructor
 		 * 
 		 * @param divider the spi divider to calculate the spi speed (84 mhz / 21 = 4mhz\n)
 		 * @param loopback to enable or disable the loopback in hardware. This connects the 
          * mosi to the miso if enabled
+         * @param word_mode use 16 bit transfers for the 16 bit writes
 		 */
-        hwspi(const uint8_t divider = 21, const bool loopback = 0) {
+        hwspi(const uint8_t divider = 21, const bool loopback = 0, const bool word_mode = true):
+            word_mode(word_mode)
+        {
+            // use the same divider for every profile
+            pdc::set_profiles(divider);
+
             // init the spi hardware
 			init(divider, loopback);
 		}
 
+        /**
+         * @brief Change the clock divider of a profile
+         * 
+         * @param profile the profile to change
+         * @param divider the spi divider to calculate the spi speed (84 mhz / divider)
+         */
+        void set_divider(const spi_profile profile, const uint8_t divider) {
+            pdc::set_divider(uint8_t(profile), divider);
+        }
+
+        /**
+         * @brief Select the clock profile for the next synchronous writes
+         * 
+         * @param profile 
+         */
+        void select_profile(const spi_profile profile) override {
+            // wait until the queued writes are done with their profile
+            wait();
+
+            pdc::apply_profile(uint8_t(profile));
+        }
+
         /**
          * @brief write and read implementation for the hardware spi
          * 
-         * @warning cs pin not used as hardware spi chip select. D10 is used instead 
+         * @warning cs pin not used as hardware spi chip select. NPCS0 (D10) is used instead
+         * and stays asserted until end_batch is called
          * 
          * @param cs 
          * @param amount
@@ -173,6 +235,16 @@ class hwspi : public hwlib::spi_bus {
          */
 		void write_and_read(hwlib::pin_out & cs, const size_t amount, const uint8_t *data_out, 
                             uint8_t *data_in) override {
+            // wait until a asynchronous write is done
+            wait();
+
+            // check if we only need to write
+            if (!data_in) {
+                pdc::write_bytes(data_out, amount);
+
+                return;
+            }
+
             // loop until we wrote/read enough data
 			for(size_t i = 0; i < amount; i++){
                 // check if we have valid data in and out
@@ -190,6 +262,147 @@ class hwspi : public hwlib::spi_bus {
                 }
 			}
 		}
+
+        /**
+         * @brief Write the same pattern multiple times to the hardware spi
+         * 
+         * @details Keeps the transmit register filled without waiting for every 
+         * byte to be shifted out
+         * 
+         * @param cs 
+         * @param amount amount of bytes in the pattern
+         * @param pattern the pattern to repeat
+         * @param count amount of times the pattern is written
+         */
+        void write_repeat(hwlib::pin_out & cs, const size_t amount, const uint8_t *pattern, 
+                          const size_t count) override {
+            // wait until a asynchronous write is done
+            wait();
+
+            pdc::write_repeat(amount, pattern, count);
+        }
+
+        /**
+         * @brief Start writing lines of data using the pdc
+         * 
+         * @details Returns directly after starting the first line. The next lines are
+         * loaded from the interrupt.
+         * 
+         * @param cs 
+         * @param amount amount of bytes in a line
+         * @param data the first line to write
+         * @param stride amount of bytes between the start of two lines
+         * @param lines amount of lines to write
+         * @param callback called from the interrupt when everything is written
+         */
+        void write_lines_async(hwlib::pin_out & cs, const size_t amount, const uint8_t *data,
+                               const size_t stride, const size_t lines,
+                               void (*callback)() = nullptr) override {
+            // wait until the previous writes are done
+            wait();
+
+            // start the lines with 8 bit transfers
+            pdc::start_lines(data, amount, stride, lines, callback, false);
+        }
+
+        /**
+         * @brief Write the same 16 bit word multiple times using 16 bit transfers
+         * 
+         * @param cs 
+         * @param word the word to repeat
+         * @param count amount of times the word is written
+         */
+        void write_repeat16(hwlib::pin_out & cs, const uint16_t word, const size_t count) override {
+            // check if we should use 8 bit transfers
+            if (!word_mode) {
+                spi_bus_extended::write_repeat16(cs, word, count);
+
+                return;
+            }
+
+            // wait until a asynchronous write is done
+            wait();
+
+            // write the words with 16 bit transfers
+            pdc::write_repeat16(word, count);
+        }
+
+        /**
+         * @brief Start writing lines of 16 bit words using the pdc with 16 bit transfers
+         * 
+         * @param cs 
+         * @param amount amount of words in a line
+         * @param data the first line to write
+         * @param stride amount of words between the start of two lines
+         * @param lines amount of lines to write
+         * @param callback called from the interrupt when everything is written
+         */
+        void write_lines16_async(hwlib::pin_out & cs, const size_t amount, const uint16_t *data,
+                                 const size_t stride, const size_t lines,
+                                 void (*callback)() = nullptr) override {
+            // check if we should use 8 bit transfers
+            if (!word_mode) {
+                spi_bus_extended::write_lines16_async(cs, amount, data, stride, lines, callback);
+
+                return;
+            }
+
+            // wait until the previous writes are done
+            wait();
+
+            // start the lines with 16 bit transfers
+            pdc::start_lines(reinterpret_cast<const uint8_t*>(data), amount, stride * 2, 
+                             lines, callback, true);
+        }
+
+        /**
+         * @brief Enable or disable 16 bit transfers for the 16 bit writes
+         * 
+         * @details When disabled the words are split in bytes and written with 
+         * 8 bit transfers
+         * 
+         * @param enable 
+         */
+        void set_word_mode(const bool enable) {
+            word_mode = enable;
+        }
+
+        /**
+         * @brief Add a transaction to the queue
+         * 
+         * @details Returns directly unless the queue is full. The transactions are
+         * written from the interrupt.
+         * 
+         * @param cs 
+         * @param transaction 
+         */
+        void enqueue(hwlib::pin_out & cs, const spi_transaction & transaction) override {
+            // words need to be split when we are not using 16 bit transfers
+            if (transaction.words && !word_mode) {
+                spi_bus_extended::enqueue(cs, transaction);
+
+                return;
+            }
+
+            pdc::enqueue(transaction);
+        }
+
+        /**
+         * @brief Release the hardware chip select after a batch of writes
+         * 
+         * @param cs 
+         */
+        void end_batch(hwlib::pin_out & cs) override {
+            pdc::end_batch();
+        }
+
+        /**
+         * @brief Wait until the asynchronous write and the queue are done
+         * 
+         */
+        void wait() override {
+            pdc::wait();
+        }
 };
 
 #endif
\ No newline at end of file
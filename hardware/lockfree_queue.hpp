@@ -0,0 +1,111 @@
+#ifndef LOCKFREE_QUEUE_HPP
+#define LOCKFREE_QUEUE_HPP
+
+#include <stddef.h>
+#include <atomic>
+
+/**
+ * @brief Lock free single producer single consumer queue
+ *
+ * @details One side (like the main loop) pushes items and the other side
+ * (like a interrupt) reads the front item and pops it when it is done with
+ * it. Does not use any hardware so it can be used on a host.
+ *
+ * @tparam T type of the items
+ * @tparam Size amount of items in the queue (one slot is always free)
+ */
+template <typename T, size_t Size>
+class lockfree_queue {
+    protected:
+        // storage for the items
+        T items[Size];
+
+        // next position to push to (only changed by the producer)
+        std::atomic<size_t> head;
+
+        // next position to pop from (only changed by the consumer)
+        std::atomic<size_t> tail;
+
+        /**
+         * @brief Get the position after a position in the queue
+         *
+         * @param position
+         * @return size_t
+         */
+        constexpr static size_t next(const size_t position) {
+            return (position + 1) % Size;
+        }
+
+    public:
+        constexpr lockfree_queue():
+            items{}, head(0), tail(0)
+        {}
+
+        /**
+         * @brief Add a item to the back of the queue
+         *
+         * @details Only call from the producer
+         *
+         * @param item
+         * @return true when the item is added
+         * @return false when the queue is full
+         */
+        bool push(const T &item) {
+            const size_t position = head.load(std::memory_order_relaxed);
+
+            // check if the queue is full
+            if (next(position) == tail.load(std::memory_order_acquire)) {
+                return false;
+            }
+
+            items[position] = item;
+
+            // publish the item to the consumer
+            head.store(next(position), std::memory_order_release);
+
+            return true;
+        }
+
+        /**
+         * @brief Get the item at the front of the queue
+         *
+         * @details Only call from the consumer
+         *
+         * @return const T* nullptr when the queue is empty
+         */
+        const T *front() const {
+            const size_t position = tail.load(std::memory_order_relaxed);
+
+            // check if the queue is empty
+            if (position == head.load(std::memory_order_acquire)) {
+                return nullptr;
+            }
+
+            return &items[position];
+        }
+
+        /**
+         * @brief Remove the item at the front of the queue
+         *
+         * @details Only call from the consumer
+         *
+         */
+        void pop() {
+            const size_t position = tail.load(std::memory_order_relaxed);
+
+            // give the slot back to the producer
+            tail.store(next(position), std::memory_order_release);
+        }
+
+        /**
+         * @brief Check if the queue is empty
+         *
+         * @return true
+         * @return false
+         */
+        bool empty() const {
+            return tail.load(std::memory_order_acquire) == head.load(std::memory_order_acquire);
+        }
+};
+
+#endif
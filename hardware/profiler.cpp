@@ -0,0 +1,56 @@
+#include "profiler.hpp"
+
+#ifdef SNAKE_PROFILE
+
+#include <hwlib.hpp>
+
+profiler::zone_stats profiler::table[uint8_t(profile_zone::count)];
+
+void profiler::reset() {
+    // enable the cycle counter
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+    for (auto &stats : table) {
+        stats = {};
+        stats.min = UINT32_MAX;
+    }
+}
+
+void profiler::dump() {
+    // names of the zones in the order of profile_zone
+    const char *names[] = {"input", "logic", "move", "spawn_food", "render", "flush"};
+
+    for (uint8_t i = 0; i < uint8_t(profile_zone::count); i++) {
+        const zone_stats &stats = table[i];
+
+        // skip the zones that are not used
+        if (!stats.count) {
+            continue;
+        }
+
+        // print all the times in cycles
+        hwlib::cout << names[i]
+                    << " count: " << int(stats.count)
+                    << " min: " << int(stats.min)
+                    << " avg: " << int(stats.total / stats.count)
+                    << " max: " << int(stats.max) << "\n";
+
+        // print the histogram up to the last used bucket
+        uint8_t last = buckets;
+
+        while (last > 0 && !stats.histogram[last - 1]) {
+            last--;
+        }
+
+        hwlib::cout << "  histogram (4^i cycles):";
+
+        for (uint8_t j = 0; j < last; j++) {
+            hwlib::cout << " " << int(stats.histogram[j]);
+        }
+
+        hwlib::cout << "\n";
+    }
+}
+
+#endif
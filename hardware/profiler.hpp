@@ -0,0 +1,172 @@
+#ifndef PROFILER_HPP
+#define PROFILER_HPP
+
+#include <stdint.h>
+
+/**
+ * @brief The parts of a frame that can be measured
+ *
+ */
+enum class profile_zone : uint8_t {
+    // reading the buttons
+    input = 0,
+
+    // the game logic including queueing the changes
+    logic = 1,
+
+    // moving the snake (part of logic)
+    move = 2,
+
+    // spawning food (part of logic)
+    spawn_food = 3,
+
+    // drawing the queued changes in the framebuffer
+    render = 4,
+
+    // sending the framebuffer to the screen
+    flush = 5,
+
+    // amount of zones
+    count = 6
+};
+
+#ifdef SNAKE_PROFILE
+
+#include <atmel\sam3xa\include\sam3xa.h>
+
+/**
+ * @brief Cycle counts of the profiling zones
+ *
+ * @details Uses the cycle counter of the Cortex-M3 (DWT->CYCCNT). Every zone
+ * keeps the min, max and total cycles and a histogram with a bucket for every
+ * power of 4 cycles in a fixed table. Only compiled when SNAKE_PROFILE is
+ * defined. Use the PROFILE_ macros so the profiling is removed otherwise.
+ *
+ */
+class profiler {
+    public:
+        // amount of buckets in the histogram. Bucket i has the counts between
+        // 4^i and 4^(i + 1) cycles
+        constexpr static uint8_t buckets = 16;
+
+        /**
+         * @brief Measurements of a single zone
+         *
+         */
+        struct zone_stats {
+            uint32_t count;
+            uint32_t min;
+            uint32_t max;
+            uint64_t total;
+            uint16_t histogram[buckets];
+        };
+
+    protected:
+        // measurements of every zone
+        static zone_stats table[uint8_t(profile_zone::count)];
+
+    public:
+        /**
+         * @brief Get the current cycle count
+         *
+         * @return uint32_t
+         */
+        static uint32_t now() {
+            return DWT->CYCCNT;
+        }
+
+        /**
+         * @brief Enable the cycle counter and clear all the measurements
+         *
+         */
+        static void reset();
+
+        /**
+         * @brief Add a measurement to a zone
+         *
+         * @param zone
+         * @param cycles
+         */
+        static void record(const profile_zone zone, const uint32_t cycles) {
+            zone_stats &stats = table[uint8_t(zone)];
+
+            stats.count++;
+            stats.total += cycles;
+
+            if (cycles < stats.min) {
+                stats.min = cycles;
+            }
+
+            if (cycles > stats.max) {
+                stats.max = cycles;
+            }
+
+            // 1 bucket for every 2 bits of the count
+            const uint8_t bucket = uint8_t((31 - __builtin_clz(cycles | 1)) / 2);
+
+            // stop counting instead of wrapping around
+            if (stats.histogram[bucket] != UINT16_MAX) {
+                stats.histogram[bucket]++;
+            }
+        }
+
+        /**
+         * @brief Get the measurements of a zone
+         *
+         * @param zone
+         * @return const zone_stats&
+         */
+        static const zone_stats &get(const profile_zone zone) {
+            return table[uint8_t(zone)];
+        }
+
+        /**
+         * @brief Print the measurements of all the zones using hwlib::cout
+         *
+         */
+        static void dump();
+};
+
+/**
+ * @brief Measures the cycles between the construction and the destruction
+ *
+ */
+class profile_scope {
+    protected:
+        // zone the cycles are added to
+        const profile_zone zone;
+
+        // cycle count at the construction
+        const uint32_t start;
+
+    public:
+        profile_scope(const profile_zone zone):
+            zone(zone), start(profiler::now())
+        {}
+
+        ~profile_scope() {
+            profiler::record(zone, profiler::now() - start);
+        }
+};
+
+#define PROFILE_CONCAT_(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_(a, b)
+
+// measure the rest of the current scope in a zone
+#define PROFILE_ZONE(zone) profile_scope PROFILE_CONCAT(profile_scope_, __LINE__)(profile_zone::zone)
+
+// clear all the measurements
+#define PROFILE_RESET() profiler::reset()
+
+// print all the measurements
+#define PROFILE_DUMP() profiler::dump()
+
+#else
+
+#define PROFILE_ZONE(zone)
+#define PROFILE_RESET()
+#define PROFILE_DUMP()
+
+#endif
+
+#endif
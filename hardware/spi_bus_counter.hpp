@@ -0,0 +1,115 @@
+#ifndef SPI_BUS_COUNTER_HPP
+#define SPI_BUS_COUNTER_HPP
+
+#include <hwlib.hpp>
+#include "spi_bus_extended.hpp"
+
+/**
+ * @brief Spi bus that counts the traffic to another spi bus
+ *
+ * @details Forwards every call to the bus it wraps and keeps track of the
+ * amount of bytes and transactions. Used to compare the spi traffic of the
+ * display functions.
+ *
+ */
+class spi_bus_counter : public spi_bus_extended {
+    protected:
+        // the bus that does the actual writes
+        spi_bus_extended & bus;
+
+    public:
+        // amount of bytes on the spi bus
+        uint32_t bytes;
+
+        // amount of calls on the spi bus
+        uint32_t transactions;
+
+        // amount of 16 bit words written with the 16 bit functions
+        uint32_t words;
+
+        /**
+         * @brief Construct a new spi bus counter
+         *
+         * @param bus the bus to count the traffic of
+         */
+        spi_bus_counter(spi_bus_extended & bus):
+            bus(bus), bytes(0), transactions(0), words(0)
+        {}
+
+        /**
+         * @brief Reset all the counters
+         *
+         */
+        void reset() {
+            bytes = 0;
+            transactions = 0;
+            words = 0;
+        }
+
+        void write_and_read(hwlib::pin_out & cs, const size_t amount, const uint8_t *data_out,
+                            uint8_t *data_in) override {
+            bytes += amount;
+            transactions++;
+
+            bus.write_and_read(cs, amount, data_out, data_in);
+        }
+
+        void write_repeat(hwlib::pin_out & cs, const size_t amount, const uint8_t *pattern,
+                          const size_t count) override {
+            bytes += amount * count;
+            transactions++;
+
+            bus.write_repeat(cs, amount, pattern, count);
+        }
+
+        void write_repeat16(hwlib::pin_out & cs, const uint16_t word, const size_t count) override {
+            bytes += count * 2;
+            words += count;
+            transactions++;
+
+            bus.write_repeat16(cs, word, count);
+        }
+
+        void write_lines_async(hwlib::pin_out & cs, const size_t amount, const uint8_t *data,
+                               const size_t stride, const size_t lines,
+                               void (*callback)() = nullptr) override {
+            bytes += amount * lines;
+            transactions++;
+
+            bus.write_lines_async(cs, amount, data, stride, lines, callback);
+        }
+
+        void write_lines16_async(hwlib::pin_out & cs, const size_t amount, const uint16_t *data,
+                                 const size_t stride, const size_t lines,
+                                 void (*callback)() = nullptr) override {
+            bytes += amount * lines * 2;
+            words += amount * lines;
+            transactions++;
+
+            bus.write_lines16_async(cs, amount, data, stride, lines, callback);
+        }
+
+        void enqueue(hwlib::pin_out & cs, const spi_transaction & transaction) override {
+            const uint32_t amount = uint32_t(transaction.size) * transaction.lines;
+
+            bytes += transaction.words ? amount * 2 : amount;
+            words += transaction.words ? amount : 0;
+            transactions++;
+
+            bus.enqueue(cs, transaction);
+        }
+
+        void select_profile(const spi_profile profile) override {
+            bus.select_profile(profile);
+        }
+
+        void end_batch(hwlib::pin_out & cs) override {
+            bus.end_batch(cs);
+        }
+
+        void wait() override {
+            bus.wait();
+        }
+};
+
+#endif
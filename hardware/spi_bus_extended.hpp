@@ -0,0 +1,222 @@
+#ifndef SPI_BUS_EXTENDED_HPP
+#define SPI_BUS_EXTENDED_HPP
+
+#include <hwlib.hpp>
+#include "spi_queue.hpp"
+
+/**
+ * @brief Spi bus with extra write functions for displays
+ *
+ * @details Adds functions on top of the hwlib spi bus that can be done faster
+ * in hardware. Every function has a default implementation that uses
+ * write_and_read so every hwlib spi bus can be used.
+ *
+ */
+class spi_bus_extended : public hwlib::spi_bus {
+    public:
+        /**
+         * @brief Write the same pattern multiple times to the spi bus
+         *
+         * @details Used to fill the screen with a single color without a buffer
+         * with all the pixels
+         *
+         * @param cs
+         * @param amount amount of bytes in the pattern
+         * @param pattern the pattern to repeat
+         * @param count amount of times the pattern is written
+         */
+        virtual void write_repeat(hwlib::pin_out & cs, const size_t amount, const uint8_t *pattern,
+                                  const size_t count) {
+            // write the pattern until we wrote it enough times
+            for (size_t i = 0; i < count; i++) {
+                write_and_read(cs, amount, pattern, nullptr);
+            }
+        }
+
+        /**
+         * @brief Write the same 16 bit word multiple times to the spi bus
+         *
+         * @details The word is send high byte first. Buses that support 16 bit 
+         * transfers can write a word with a single transfer.
+         *
+         * @param cs
+         * @param word the word to repeat
+         * @param count amount of times the word is written
+         */
+        virtual void write_repeat16(hwlib::pin_out & cs, const uint16_t word, const size_t count) {
+            // convert the word to a pattern that is send high byte first
+            const uint8_t pattern[2] = {uint8_t(word >> 8), uint8_t(word & 0xFF)};
+
+            write_repeat(cs, sizeof(pattern), pattern, count);
+        }
+
+        /**
+         * @brief Start writing lines of 16 bit words from a larger buffer to the spi bus
+         *
+         * @details Every word is send high byte first. The data should stay valid
+         * until the callback is called or until wait returns. The default 
+         * implementation converts the words to bytes and writes everything before
+         * returning.
+         *
+         * @param cs
+         * @param amount amount of words in a line
+         * @param data the first line to write
+         * @param stride amount of words between the start of two lines
+         * @param lines amount of lines to write
+         * @param callback called when everything is written. Can be called from
+         * a interrupt
+         */
+        virtual void write_lines16_async(hwlib::pin_out & cs, const size_t amount, const uint16_t *data,
+                                         const size_t stride, const size_t lines,
+                                         void (*callback)() = nullptr) {
+            // buffer for the converted words
+            uint8_t buffer[32];
+
+            for (size_t i = 0; i < lines; i++) {
+                const uint16_t *line = data + (i * stride);
+
+                // convert and write the line in parts that fit in the buffer
+                for (size_t j = 0; j < amount;) {
+                    size_t size = 0;
+
+                    for (; j < amount && size < sizeof(buffer); j++) {
+                        buffer[size++] = uint8_t(line[j] >> 8);
+                        buffer[size++] = uint8_t(line[j] & 0xFF);
+                    }
+
+                    write_and_read(cs, size, buffer, nullptr);
+                }
+            }
+
+            // notify we are done
+            if (callback) {
+                callback();
+            }
+        }
+
+        /**
+         * @brief Start writing lines of data from a larger buffer to the spi bus
+         *
+         * @details Returns as soon as the transfer is started when the bus supports
+         * it. The data should stay valid until the callback is called or until
+         * wait returns. The default implementation writes everything before
+         * returning.
+         *
+         * @param cs
+         * @param amount amount of bytes in a line
+         * @param data the first line to write
+         * @param stride amount of bytes between the start of two lines
+         * @param lines amount of lines to write
+         * @param callback called when everything is written. Can be called from
+         * a interrupt
+         */
+        virtual void write_lines_async(hwlib::pin_out & cs, const size_t amount, const uint8_t *data,
+                                       const size_t stride, const size_t lines,
+                                       void (*callback)() = nullptr) {
+            // write every line
+            for (size_t i = 0; i < lines; i++) {
+                write_and_read(cs, amount, data + (i * stride), nullptr);
+            }
+
+            // notify we are done
+            if (callback) {
+                callback();
+            }
+        }
+
+        /**
+         * @brief Start writing data to the spi bus
+         *
+         * @param cs
+         * @param amount amount of bytes to write
+         * @param data the data to write
+         * @param callback called when everything is written. Can be called from
+         * a interrupt
+         */
+        void write_async(hwlib::pin_out & cs, const size_t amount, const uint8_t *data,
+                         void (*callback)() = nullptr) {
+            // write the data as a single line
+            write_lines_async(cs, amount, data, amount, 1, callback);
+        }
+
+        /**
+         * @brief Select the clock profile for the next writes
+         *
+         * @details The default implementation uses a single clock for everything
+         *
+         * @param profile
+         */
+        virtual void select_profile(const spi_profile profile) {
+            // only a single clock in the default implementation
+        }
+
+        /**
+         * @brief Add a transaction to the queue of the spi bus
+         *
+         * @details The transaction is written after all the writes that are
+         * already started. Pointers in the transaction should stay valid until
+         * wait returns. The default implementation writes the transaction
+         * before returning.
+         *
+         * @param cs
+         * @param transaction
+         */
+        virtual void enqueue(hwlib::pin_out & cs, const spi_transaction & transaction) {
+            // wait until the previous writes are done before changing the dc pin
+            wait();
+
+            if (transaction.dc) {
+                transaction.dc->set(transaction.dc_level);
+            }
+
+            select_profile(transaction.profile);
+
+            // check if we need to write words or bytes
+            if (!transaction.words) {
+                write_lines_async(cs, transaction.size, transaction.get_data(), 
+                                  transaction.stride, transaction.lines);
+            }
+            else if (transaction.size == 1 && transaction.stride == 0) {
+                // the same word multiple times
+                write_repeat16(cs, *reinterpret_cast<const uint16_t*>(transaction.get_data()), 
+                               transaction.lines);
+            }
+            else {
+                write_lines16_async(cs, transaction.size, 
+                                    reinterpret_cast<const uint16_t*>(transaction.get_data()),
+                                    transaction.stride, transaction.lines);
+            }
+
+            // wait until the transaction is written
+            wait();
+
+            if (transaction.release_cs) {
+                end_batch(cs);
+            }
+        }
+
+        /**
+         * @brief Release the chip select after a batch of writes
+         *
+         * @details Buses that keep the chip select asserted between writes release
+         * it after all the writes are done. The default implementation does nothing.
+         *
+         * @param cs
+         */
+        virtual void end_batch(hwlib::pin_out & cs) {
+            // nothing to release in the default implementation
+        }
+
+        /**
+         * @brief Wait until all the asynchronous and queued writes are done
+         *
+         * @details Needs to be called before changing pins (like the data/command
+         * pin of a display) that need to stay the same during a write
+         *
+         */
+        virtual void wait() {
+            // nothing to wait for in the default implementation
+        }
+};
+
+#endif
@@ -0,0 +1,587 @@
+#ifndef SPI_PDC_HPP
+#define SPI_PDC_HPP
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "spi_queue.hpp"
+
+/**
+ * @brief The transfers of the sam3x8e hardware spi and its pdc
+ *
+ * @details Writes bytes and 16 bit words, starts the asynchronous line writes
+ * on the pdc and writes the queued transactions from the interrupt. Every
+ * register is reached through Registers so the transfers can be tested on a
+ * host with a stand-in for the spi and the pdc. The register bits (like
+ * SPI_SR_TXEMPTY) need to be defined before this file is included, by the
+ * sam3xa headers or by the stand-in.
+ *
+ * @tparam Registers type with a static spi() that returns the spi registers
+ * and a static interrupt(bool) that enables or disables the spi interrupt
+ */
+template <typename Registers>
+class spi_pdc {
+    public:
+        // amount of transactions in the queue
+        constexpr static size_t queue_size = 16;
+
+        // amount of words in the buffer used to repeat a single word
+        constexpr static size_t fill_size = 32;
+
+        // amount of clock profiles
+        constexpr static uint8_t profile_count = 4;
+
+    protected:
+        // if a asynchronous write is in progress
+        static volatile bool busy;
+
+        // the transactions that are not written yet. The front transaction
+        // is the one that is being written
+        static spi_queue<queue_size> queue;
+
+        // buffer with a repeated word for the queued fills
+        static uint16_t fill_buffer[fill_size];
+
+        // amount of words of the queued fill that do not fit a whole buffer
+        static size_t fill_left;
+
+        // the clock divider field of every profile
+        static uint32_t profiles[profile_count];
+
+        // the profile that is in the chip select register
+        static uint8_t active_profile;
+
+        // the next line of the asynchronous write
+        static const uint8_t *volatile next_line;
+
+        // amount of lines the asynchronous write still needs to start
+        static volatile size_t lines_left;
+
+        // amount of transfers in a line of the asynchronous write
+        static size_t line_size;
+
+        // amount of bytes between the start of two lines
+        static size_t line_stride;
+
+        // called when the asynchronous write is done
+        static void (*volatile callback)();
+
+        // if the asynchronous write uses 16 bit transfers
+        static bool word_transfer;
+
+        /**
+         * @brief Wait until the last transfer is shifted out
+         *
+         */
+        static void wait_empty() {
+            while ((Registers::spi()->SPI_SR & SPI_SR_TXEMPTY) == 0) {
+                // wait until the write is done
+            }
+        }
+
+        /**
+         * @brief Get the address of the next line and move to the line after it
+         *
+         * @return uintptr_t address for a pdc pointer register
+         */
+        static uintptr_t take_line() {
+            const uint8_t *line = next_line;
+
+            next_line = line + line_stride;
+            lines_left = lines_left - 1;
+
+            return reinterpret_cast<uintptr_t>(line);
+        }
+
+        /**
+         * @brief Start writing the transaction at the front of the queue
+         *
+         * @details Only call when no write is in progress (from the interrupt or
+         * with the interrupt disabled)
+         *
+         */
+        static void start_transaction() {
+            const spi_transaction *transaction = queue.front();
+
+            // check if there is anything left to write
+            if (!transaction) {
+                return;
+            }
+
+            // wait until the last byte is shifted out before changing the dc pin
+            wait_empty();
+
+            if (transaction->dc) {
+                transaction->dc->set(transaction->dc_level);
+            }
+
+            // change the clock to the profile of the transaction
+            apply_profile(uint8_t(transaction->profile));
+
+            const uint8_t *data = transaction->get_data();
+
+            // check if it is a fill with a single word
+            if (transaction->words && transaction->size == 1 && transaction->stride == 0) {
+                // a pdc transfer for every word is too slow. Repeat a buffer
+                // with the word instead
+                const uint16_t word = *reinterpret_cast<const uint16_t*>(data);
+
+                for (size_t i = 0; i < fill_size; i++) {
+                    fill_buffer[i] = word;
+                }
+
+                // write the remainder after all the full buffers
+                fill_left = transaction->lines % fill_size;
+
+                start_lines(reinterpret_cast<const uint8_t*>(fill_buffer), fill_size, 0,
+                            transaction->lines / fill_size, fill_done, true);
+
+                return;
+            }
+
+            // write all the lines of the transaction
+            start_lines(
+                data, transaction->size,
+                transaction->words ? transaction->stride * 2 : transaction->stride,
+                transaction->lines, transaction_done, transaction->words
+            );
+        }
+
+        /**
+         * @brief Called when all the full buffers of a queued fill are written
+         *
+         */
+        static void fill_done() {
+            // write the words that did not fit a whole buffer
+            start_lines(reinterpret_cast<const uint8_t*>(fill_buffer), fill_left, 0, 1,
+                        transaction_done, true);
+        }
+
+        /**
+         * @brief Called when the transaction at the front of the queue is written
+         *
+         */
+        static void transaction_done() {
+            // check if the transaction ends a batch. The last byte is already shifted out
+            if (queue.front()->release_cs) {
+                Registers::spi()->SPI_CR = SPI_CR_LASTXFER;
+            }
+
+            // remove the transaction and start the next one
+            queue.pop();
+
+            start_transaction();
+        }
+
+    public:
+        /**
+         * @brief Use the same clock divider for every profile
+         *
+         * @param divider the spi divider (84 mhz / divider)
+         */
+        static void set_profiles(const uint8_t divider) {
+            for (uint8_t i = 0; i < profile_count; i++) {
+                profiles[i] = SPI_CSR_SCBR(divider);
+            }
+
+            active_profile = 0;
+        }
+
+        /**
+         * @brief Change the clock divider of a profile
+         *
+         * @param profile the profile to change
+         * @param divider the spi divider (84 mhz / divider)
+         */
+        static void set_divider(const uint8_t profile, const uint8_t divider) {
+            // wait until nothing is using the profile
+            wait();
+
+            profiles[profile] = SPI_CSR_SCBR(divider);
+
+            // force the chip select register to be updated if the profile is in use
+            if (active_profile == profile) {
+                active_profile = profile_count;
+
+                apply_profile(profile);
+            }
+        }
+
+        /**
+         * @brief Change the clock divider to the divider of a profile
+         *
+         * @details Only call when no write is in progress
+         *
+         * @param profile
+         */
+        static void apply_profile(const uint8_t profile) {
+            // check if we need to change the divider
+            if (profile == active_profile) {
+                return;
+            }
+
+            // wait until the last transfer is shifted out
+            wait_empty();
+
+            // update the divider in the chip select register
+            const auto spi = Registers::spi();
+            spi->SPI_CSR[0] = (spi->SPI_CSR[0] & ~SPI_CSR_SCBR_Msk) | profiles[profile];
+
+            active_profile = profile;
+        }
+
+        /**
+         * @brief Change the amount of bits in a transfer
+         *
+         * @details Waits until the last transfer is shifted out before changing
+         *
+         * @param sixteen 16 or 8 bit transfers
+         */
+        static void set_bits(const bool sixteen) {
+            // wait until the last transfer is shifted out
+            wait_empty();
+
+            // update the amount of bits in the chip select register
+            const auto spi = Registers::spi();
+            spi->SPI_CSR[0] = (spi->SPI_CSR[0] & ~SPI_CSR_BITS_Msk) |
+                              (sixteen ? SPI_CSR_BITS_16_BIT : SPI_CSR_BITS_8_BIT);
+        }
+
+        /**
+         * @brief Write one byte and wait until the transmit register is free
+         *
+         * @param data
+         */
+        static void write(const uint8_t data) {
+            const auto spi = Registers::spi();
+
+            // wait until the tx buffer is empty
+            wait_empty();
+
+            // write the data
+            spi->SPI_TDR = data | SPI_PCS(0);
+
+            // wait until the data is written
+            while ((spi->SPI_SR & SPI_SR_TDRE) == 0) {
+                // wait until the write is done
+            }
+        }
+
+        /**
+         * @brief Read one byte
+         *
+         * @return uint8_t
+         */
+        static uint8_t read() {
+            const auto spi = Registers::spi();
+
+            while ((spi->SPI_SR & SPI_SR_RDRF) == 0) {
+                // wait until data is ready
+            }
+
+            // return the last byte from the register
+            return spi->SPI_RDR & 0xFF;
+        }
+
+        /**
+         * @brief Write bytes
+         *
+         * @details Keeps the transmit register filled without waiting for every
+         * byte to be shifted out. Returns when the last byte is shifted out so
+         * the data/command pin can be changed directly after.
+         *
+         * @param data
+         * @param amount
+         */
+        static void write_bytes(const uint8_t *data, const size_t amount) {
+            const auto spi = Registers::spi();
+
+            for (size_t i = 0; i < amount; i++) {
+                // wait until the transmit register can take a new byte
+                while ((spi->SPI_SR & SPI_SR_TDRE) == 0) {
+                    // wait until we can write data
+                }
+
+                // write the data
+                spi->SPI_TDR = data[i] | SPI_PCS(0);
+            }
+
+            // wait until the last byte is shifted out
+            wait_empty();
+
+            // drop the received byte so a next read does not get old data
+            (void)spi->SPI_RDR;
+        }
+
+        /**
+         * @brief Write the same pattern multiple times
+         *
+         * @details Keeps the transmit register filled without waiting for every
+         * byte to be shifted out
+         *
+         * @param amount amount of bytes in the pattern
+         * @param pattern the pattern to repeat
+         * @param count amount of times the pattern is written
+         */
+        static void write_repeat(const size_t amount, const uint8_t *pattern, const size_t count) {
+            const auto spi = Registers::spi();
+
+            for (size_t i = 0; i < count; i++) {
+                for (size_t j = 0; j < amount; j++) {
+                    // wait until the transmit register can take a new byte
+                    while ((spi->SPI_SR & SPI_SR_TDRE) == 0) {
+                        // wait until we can write data
+                    }
+
+                    // write the data
+                    spi->SPI_TDR = pattern[j] | SPI_PCS(0);
+                }
+            }
+
+            // wait until the last byte is shifted out
+            wait_empty();
+
+            // drop the received byte so a next read does not get old data
+            (void)spi->SPI_RDR;
+        }
+
+        /**
+         * @brief Write the same 16 bit word multiple times using 16 bit transfers
+         *
+         * @param word the word to repeat
+         * @param count amount of times the word is written
+         */
+        static void write_repeat16(const uint16_t word, const size_t count) {
+            const auto spi = Registers::spi();
+
+            // switch to 16 bit transfers
+            set_bits(true);
+
+            for (size_t i = 0; i < count; i++) {
+                // wait until the transmit register can take a new word
+                while ((spi->SPI_SR & SPI_SR_TDRE) == 0) {
+                    // wait until we can write data
+                }
+
+                // write the data
+                spi->SPI_TDR = word;
+            }
+
+            // switch back to 8 bit transfers. Waits until the last word is send
+            set_bits(false);
+
+            // drop the received word so a next read does not get old data
+            (void)spi->SPI_RDR;
+        }
+
+        /**
+         * @brief Start writing lines using the pdc
+         *
+         * @details The first line is loaded in the current buffer of the pdc and
+         * the second line in the next buffer. The interrupt loads every next
+         * line in the next buffer while the pdc writes the current one, so
+         * the pdc does not stop between the lines.
+         *
+         * @param data the first line to write
+         * @param amount amount of transfers in a line
+         * @param stride amount of bytes between the start of two lines
+         * @param lines amount of lines to write
+         * @param callback called from the interrupt when everything is written
+         * @param sixteen use 16 bit transfers
+         */
+        static void start_lines(const uint8_t *data, const size_t amount, const size_t stride,
+                                const size_t lines, void (*callback)(), const bool sixteen) {
+            // check if we have anything to write
+            if (!amount || !lines) {
+                if (callback) {
+                    callback();
+                }
+
+                return;
+            }
+
+            // wait until the last synchronous byte is send and change the
+            // transfer size if needed
+            if (sixteen) {
+                set_bits(true);
+            }
+            else {
+                wait_empty();
+            }
+
+            // store the lines for the interrupt
+            busy = true;
+            spi_pdc::callback = callback;
+            word_transfer = sixteen;
+            line_size = amount;
+            line_stride = stride;
+            next_line = data;
+            lines_left = lines;
+
+            const auto spi = Registers::spi();
+
+            // load the first line in the current buffer of the pdc
+            spi->SPI_TPR = take_line();
+            spi->SPI_TCR = amount;
+
+            // and the second line in the next buffer
+            if (lines_left) {
+                spi->SPI_TNPR = take_line();
+                spi->SPI_TNCR = amount;
+            }
+
+            spi->SPI_PTCR = PERIPH_PTCR_TXTEN;
+
+            // let the interrupt load the next lines
+            spi->SPI_IER = SPI_IER_ENDTX;
+        }
+
+        /**
+         * @brief Interrupt handler for the asynchronous writes
+         *
+         * @details Called from the spi interrupt. Loads the next line in the
+         * next buffer of the pdc until all the lines are started and calls the
+         * callback when the last byte is shifted out.
+         *
+         */
+        static void interrupt_handler() {
+            const auto spi = Registers::spi();
+
+            // only handle the interrupts that are enabled
+            const uint32_t status = spi->SPI_SR & spi->SPI_IMR;
+
+            // the current buffer is done and the pdc moved to the next buffer
+            if (status & SPI_SR_ENDTX) {
+                // the pdc stops when the interrupt was too late to load the
+                // next buffer. Start it again with the next line
+                if (lines_left && spi->SPI_TCR == 0) {
+                    spi->SPI_TPR = take_line();
+                    spi->SPI_TCR = line_size;
+                }
+
+                if (lines_left) {
+                    // keep the next line ready so there is no gap
+                    spi->SPI_TNPR = take_line();
+                    spi->SPI_TNCR = line_size;
+                }
+                else {
+                    // all the lines are started. Wait until the last byte is send
+                    spi->SPI_IDR = SPI_IDR_ENDTX;
+                    spi->SPI_IER = SPI_IER_TXEMPTY;
+                }
+            }
+
+            // check if the last byte is shifted out and the pdc has nothing left
+            if ((status & SPI_SR_TXEMPTY) && spi->SPI_TCR == 0 && spi->SPI_TNCR == 0) {
+                // stop the pdc and the interrupts
+                spi->SPI_IDR = SPI_IDR_TXEMPTY;
+                spi->SPI_PTCR = PERIPH_PTCR_TXTDIS;
+
+                // go back to 8 bit transfers for the commands
+                if (word_transfer) {
+                    set_bits(false);
+                    word_transfer = false;
+                }
+
+                // drop the received byte so a next read does not get old data
+                (void)spi->SPI_RDR;
+
+                // get the callback before we mark the bus as free
+                void (*cb)() = callback;
+                callback = nullptr;
+
+                busy = false;
+
+                if (cb) {
+                    cb();
+                }
+            }
+        }
+
+        /**
+         * @brief Add a transaction to the queue
+         *
+         * @details Returns directly unless the queue is full. The transactions are
+         * written from the interrupt.
+         *
+         * @param transaction
+         */
+        static void enqueue(const spi_transaction & transaction) {
+            while (!queue.push(transaction)) {
+                // wait until the interrupt has written a transaction
+            }
+
+            // start the queue if nothing is being written. The interrupt is
+            // disabled so it cannot start the same transaction
+            Registers::interrupt(false);
+
+            if (!busy) {
+                start_transaction();
+            }
+
+            Registers::interrupt(true);
+        }
+
+        /**
+         * @brief Release the hardware chip select after a batch of writes
+         *
+         */
+        static void end_batch() {
+            // wait until all the writes are done
+            wait();
+
+            // wait until the last byte is shifted out
+            wait_empty();
+
+            // deassert npcs0
+            Registers::spi()->SPI_CR = SPI_CR_LASTXFER;
+        }
+
+        /**
+         * @brief Wait until the asynchronous write and the queue are done
+         *
+         */
+        static void wait() {
+            while (busy || !queue.empty()) {
+                // wait until the interrupt marks the write as done
+            }
+        }
+};
+
+template <typename Registers>
+volatile bool spi_pdc<Registers>::busy = false;
+
+template <typename Registers>
+spi_queue<spi_pdc<Registers>::queue_size> spi_pdc<Registers>::queue;
+
+template <typename Registers>
+uint16_t spi_pdc<Registers>::fill_buffer[spi_pdc<Registers>::fill_size] = {};
+
+template <typename Registers>
+size_t spi_pdc<Registers>::fill_left = 0;
+
+template <typename Registers>
+uint32_t spi_pdc<Registers>::profiles[spi_pdc<Registers>::profile_count] = {};
+
+template <typename Registers>
+uint8_t spi_pdc<Registers>::active_profile = 0;
+
+template <typename Registers>
+const uint8_t *volatile spi_pdc<Registers>::next_line = nullptr;
+
+template <typename Registers>
+volatile size_t spi_pdc<Registers>::lines_left = 0;
+
+template <typename Registers>
+size_t spi_pdc<Registers>::line_size = 0;
+
+template <typename Registers>
+size_t spi_pdc<Registers>::line_stride = 0;
+
+template <typename Registers>
+void (*volatile spi_pdc<Registers>::callback)() = nullptr;
+
+template <typename Registers>
+bool spi_pdc<Registers>::word_transfer = false;
+
+#endif
@@ -0,0 +1,83 @@
+#ifndef SPI_QUEUE_HPP
+#define SPI_QUEUE_HPP
+
+#include <stdint.h>
+#include <stddef.h>
+#include <hwlib.hpp>
+
+#include "lockfree_queue.hpp"
+
+/**
+ * @brief Clock profiles of the spi bus
+ *
+ */
+enum class spi_profile : uint8_t {
+    // conservative clock for the init sequence and commands
+    command = 0,
+
+    // fastest clock the device supports for bulk data
+    data = 1
+};
+
+/**
+ * @brief A single write on the spi bus that can be queued
+ *
+ * @details Writes lines of data (or the same data multiple times when the stride
+ * is 0) with the data/command pin at a fixed level. Small writes like commands
+ * can store the data in the transaction itself.
+ *
+ */
+struct spi_transaction {
+    // data/command pin to set before writing. nullptr to leave the pin alone
+    hwlib::pin_out *dc;
+
+    // level of the data/command pin during the write
+    bool dc_level;
+
+    // if the data are 16 bit words instead of bytes
+    bool words;
+
+    // amount of bytes or words in a line
+    uint16_t size;
+
+    // amount of bytes or words between the start of two lines. 0 to repeat the same line
+    uint16_t stride;
+
+    // amount of lines to write
+    uint32_t lines;
+
+    // release the chip select after the transaction to end a batch
+    bool release_cs;
+
+    // clock profile of the spi bus during the write
+    spi_profile profile;
+
+    // the data to write. nullptr to use the inline data
+    const void *data;
+
+    // inline data for small writes
+    alignas(4) uint8_t inline_data[4];
+
+    /**
+     * @brief Get a pointer to the data of the transaction
+     *
+     * @return const uint8_t*
+     */
+    const uint8_t *get_data() const {
+        return data ? static_cast<const uint8_t*>(data) : inline_data;
+    }
+};
+
+/**
+ * @brief Lock free queue of spi transactions
+ *
+ * @details The producer (the main loop) pushes transactions and the consumer
+ * (the spi interrupt) only pops a transaction after it is written. The inline
+ * data of the front transaction stays valid until it is popped.
+ *
+ * @tparam Size amount of transactions in the queue (one slot is always free)
+ */
+template <size_t Size>
+using spi_queue = lockfree_queue<spi_transaction, Size>;
+
+#endif
@@ -0,0 +1,39 @@
+#ifndef SPI_REGISTERS_HPP
+#define SPI_REGISTERS_HPP
+
+#include <atmel\sam3xa\include\sam3xa.h>
+
+/**
+ * @brief The registers of the first hardware spi of the sam3x8e
+ *
+ * @details Used by spi_pdc to reach the spi and pdc registers and the
+ * interrupt of the spi. A host can use its own version of this file with a
+ * stand-in for the registers.
+ *
+ */
+struct spi0_registers {
+    /**
+     * @brief Get the spi registers with the pdc registers
+     *
+     * @return Spi*
+     */
+    static Spi *spi() {
+        return SPI0;
+    }
+
+    /**
+     * @brief Enable or disable the interrupt of the spi
+     *
+     * @param enable
+     */
+    static void interrupt(const bool enable) {
+        if (enable) {
+            NVIC_EnableIRQ(SPI0_IRQn);
+        }
+        else {
+            NVIC_DisableIRQ(SPI0_IRQn);
+        }
+    }
+};
+
+#endif
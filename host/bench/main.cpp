@@ -0,0 +1,230 @@
+#include <hwlib.hpp>
+#include <stdio.h>
+#include <chrono>
+
+#include "spi_bus_recorder.hpp"
+#include "hwlib_ssd1351_buffered.hpp"
+#include "snake.hpp"
+
+// size of the game and the screen
+constexpr static uint8_t width = 32;
+constexpr static uint8_t height = 32;
+constexpr static uint8_t screen_width = 128;
+constexpr static uint8_t screen_height = 128;
+
+// seed of the food so every run is the same
+constexpr static uint32_t food_seed = 0x1234;
+
+// file with the results. The results are also written to the console
+static FILE *results = nullptr;
+
+/**
+ * @brief Write a line of the results to the console and the file
+ *
+ * @param line
+ */
+void write_line(const char *line) {
+    fputs(line, stdout);
+
+    if (results) {
+        fputs(line, results);
+    }
+}
+
+/**
+ * @brief Game rules with access to the food spawning
+ *
+ */
+class logic_bench : public game::snake_logic<width, height> {
+    public:
+        using game::snake_logic<width, height>::spawn_food;
+
+        /**
+         * @brief Fill a part of the empty positions with the snake
+         *
+         * @param percentage amount of empty positions to fill
+         */
+        void fill(const uint8_t percentage) {
+            // the amount of empty positions changes while filling
+            const size_t amount = (free_cells.size() * percentage) / 100;
+
+            for (size_t i = 0; i < amount; i++) {
+                set_cell(map_position(free_cells[0]), game::cell::snake);
+            }
+        }
+
+        /**
+         * @brief Remove the food again so the fill level stays the same
+         *
+         * @param events the events of spawn_food
+         */
+        void remove_food(const game::step_events &events) {
+            for (uint8_t i = 0; i < events.count; i++) {
+                set_cell(events.changes[i].position, game::cell::empty);
+            }
+        }
+};
+
+/**
+ * @brief Snake game with access to the drawing functions
+ *
+ */
+class snake_bench : public game::snake<width, height, screen_width, screen_height> {
+    public:
+        using game::snake<width, height, screen_width, screen_height>::snake;
+        using game::snake<width, height, screen_width, screen_height>::draw;
+        using game::snake<width, height, screen_width, screen_height>::render;
+        using game::snake<width, height, screen_width, screen_height>::write_screen_block;
+        using game::snake<width, height, screen_width, screen_height>::start_screen;
+        using game::snake<width, height, screen_width, screen_height>::write_score;
+
+        /**
+         * @brief Start a new game on a cleared window
+         *
+         */
+        void restart() {
+            background = window.background;
+
+            window.clear();
+
+            draw(logic.reset(food_seed));
+            render();
+
+            window.flush();
+        }
+
+        /**
+         * @brief Do a step of the game and draw it
+         *
+         * @details Turns every 8 steps so the snake moves in a square. A new
+         * game is started when the snake dies.
+         *
+         * @param count number of the step
+         */
+        void step(const uint32_t count) {
+            const game::step_events events = logic.step((count % 8) ? 0 : 0x1);
+
+            draw(events);
+            render();
+
+            window.flush();
+
+            if (events.result == game::step_result::died || events.result == game::step_result::won) {
+                restart();
+            }
+        }
+};
+
+/**
+ * @brief Run a benchmark and write the time and the spi traffic of a single run
+ *
+ * @tparam T
+ * @param name name of the benchmark
+ * @param runs amount of times the benchmark is run
+ * @param bus the bus to the display
+ * @param dc the data/command pin of the display
+ * @param benchmark the function to measure. Gets the number of the run
+ */
+template <typename T>
+void run_benchmark(const char *name, const uint32_t runs, spi_bus_recorder & bus,
+                   const host_pin & dc, T benchmark) {
+    // reset the counters of the previous benchmark
+    bus.reset();
+
+    const auto start = std::chrono::steady_clock::now();
+
+    for (uint32_t i = 0; i < runs; i++) {
+        benchmark(i);
+    }
+
+    const auto time = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - start).count();
+
+    // one line per benchmark with the values of a single run
+    char line[128];
+
+    snprintf(line, sizeof(line), "%s,%lld,%.1f,%.1f,%.1f\n", name, static_cast<long long>(time / runs),
+             double(bus.bytes) / runs, double(bus.transactions) / runs, double(dc.toggles) / runs);
+
+    write_line(line);
+}
+
+int main() {
+    // the emulated display and the pins that are connected to it
+    auto panel = ssd1351_emulator();
+    auto reset = host_pin(true);
+    auto dc = host_pin();
+    auto cs = host_pin(true);
+
+    // bus that sends everything to the emulated display
+    auto bus = spi_bus_recorder(panel, dc);
+
+    // the same display and game the device uses
+    auto display = hwlib_ssd1351_buffered(bus, reset, dc, cs);
+    auto buttons = due_buttons();
+    auto game = snake_bench(display, buttons);
+
+    // write the results to the console and to a file
+    results = fopen("bench.csv", "w");
+
+    write_line("name,ns_per_op,spi_bytes_per_op,spi_transactions_per_op,dc_toggles_per_op\n");
+
+    // game rules without drawing
+    auto rules = logic_bench();
+    rules.reset(food_seed);
+
+    run_benchmark("logic_step", 100'000, bus, dc, [&](uint32_t i) {
+        const auto events = rules.step((i % 8) ? 0 : 0x1);
+
+        if (events.result == game::step_result::died || events.result == game::step_result::won) {
+            rules.reset(food_seed);
+        }
+    });
+
+    // spawning food with a part of the board taken by the snake
+    const uint8_t levels[] = {0, 50, 90, 99};
+    const char *names[] = {"spawn_food_0", "spawn_food_50", "spawn_food_90", "spawn_food_99"};
+
+    for (uint8_t i = 0; i < sizeof(levels); i++) {
+        rules.reset(food_seed);
+        rules.fill(levels[i]);
+
+        run_benchmark(names[i], 100'000, bus, dc, [&](uint32_t) {
+            game::step_events events = {};
+
+            rules.spawn_food(events);
+            rules.remove_food(events);
+        });
+    }
+
+    // a step of the game including drawing it on the screen
+    game.restart();
+
+    run_benchmark("step_render", 10'000, bus, dc, [&](uint32_t i) {
+        game.step(i);
+    });
+
+    run_benchmark("write_screen_block", 10'000, bus, dc, [&](uint32_t i) {
+        game.write_screen_block(uint16_t(i % (width * height)), (i & 1) ? color565::red : color565::green);
+        display.flush();
+    });
+
+    run_benchmark("start_screen", 100, bus, dc, [&](uint32_t) {
+        game.start_screen();
+        display.flush();
+    });
+
+    run_benchmark("clear", 100, bus, dc, [&](uint32_t) {
+        display.clear();
+        display.flush();
+    });
+
+    run_benchmark("write_score", 100, bus, dc, [&](uint32_t) {
+        game.write_score(false);
+        display.flush();
+    });
+
+    if (results) {
+        fclose(results);
+    }
+}
@@ -0,0 +1,113 @@
+#ifndef DUE_BUTTONS_HPP
+#define DUE_BUTTONS_HPP
+
+#include <stdint.h>
+
+#include "lockfree_queue.hpp"
+#include "button_event.hpp"
+
+/**
+ * @brief Stand-in for the due buttons on a host
+ *
+ * @details Has the same interface as the due buttons so the game can be
+ * compiled for a host. The changes are added with change instead of an
+ * interrupt.
+ *
+ */
+class due_buttons {
+    protected:
+        // amount of events in the queue
+        constexpr static size_t queue_size = 8;
+
+        // the changes that are not read yet
+        lockfree_queue<button_event, queue_size> queue;
+
+        // the state of the buttons
+        uint8_t state;
+
+    public:
+        /**
+         * @brief Construct a new due buttons object
+         *
+         * @param debounce_us not used on a host
+         */
+        due_buttons(const uint32_t debounce_us = 5'000):
+            state(0)
+        {}
+
+        /**
+         * @brief Add a change of a button
+         *
+         * @param button the button that changed (bit 0 = D4, bit 1 = D3)
+         * @param pressed if the button is pressed or released
+         */
+        void change(const uint8_t button, const bool pressed) {
+            state = pressed ? (state | button) : (state & ~button);
+
+            queue.push({0, button, pressed, state});
+        }
+
+        /**
+         * @brief Get the next button change
+         *
+         * @param event the change. Only valid when true is returned
+         * @return true when there was a change
+         * @return false when the queue is empty
+         */
+        bool pop(button_event &event) {
+            const button_event *front = queue.front();
+
+            if (!front) {
+                return false;
+            }
+
+            event = *front;
+            queue.pop();
+
+            return true;
+        }
+
+        /**
+         * @brief Get the next button change without removing it
+         *
+         * @return const button_event* nullptr when there is no change
+         */
+        const button_event *peek() const {
+            return queue.front();
+        }
+
+        /**
+         * @brief Remove all the changes that are not read yet
+         *
+         */
+        void clear() {
+            while (queue.front()) {
+                queue.pop();
+            }
+        }
+
+        /**
+         * @brief Get the state of the buttons
+         *
+         * @return uint8_t bit 0 = D4, bit 1 = D3
+         */
+        uint8_t get() const {
+            return state;
+        }
+
+        /**
+         * @brief Wait until a condition is true
+         *
+         * @details Nothing to sleep for on a host. The condition is checked
+         * until it is true
+         *
+         * @tparam F
+         * @param condition function that returns true to stop waiting
+         */
+        template <typename F>
+        static void sleep_until(F condition) {
+            while (!condition()) {}
+        }
+};
+
+#endif
@@ -0,0 +1,151 @@
+#ifndef FRAME_SCHEDULER_HPP
+#define FRAME_SCHEDULER_HPP
+
+#include <stdint.h>
+#include <chrono>
+
+#include "frame_stats.hpp"
+
+/**
+ * @brief Stand-in for the frame scheduler on a host
+ *
+ * @details Has the same interface as the scheduler on the due so the game can
+ * be compiled for a host. Frames start right away and the times are measured
+ * with the steady clock.
+ *
+ */
+class frame_scheduler {
+    protected:
+        // time the current frame started
+        uint64_t frame_start = 0;
+
+        // time between the start of the last two frames
+        uint32_t interval = 0;
+
+        // time from the start to the end of drawing of the last frame
+        uint32_t frame_time = 0;
+
+        // time the game logic of the current frame ended
+        uint64_t logic_end = 0;
+
+        // timing of the frames
+        frame_stats stats = {};
+
+        /**
+         * @brief Get the current time
+         *
+         * @return uint64_t time in ns
+         */
+        static uint64_t now() {
+            return uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count());
+        }
+
+    public:
+        /**
+         * @brief Construct a new frame scheduler object
+         *
+         * @param period_us not used on a host
+         */
+        frame_scheduler(const uint32_t period_us) {
+            start();
+        }
+
+        /**
+         * @brief Reset the statistics
+         *
+         */
+        void start() {
+            frame_start = now();
+            logic_end = frame_start;
+
+            stats = {};
+        }
+
+        /**
+         * @brief Start the next frame right away
+         *
+         */
+        void wait() {
+            const uint64_t start = now();
+
+            interval = uint32_t(start - frame_start);
+            frame_start = start;
+            logic_end = frame_start;
+
+            stats.frames++;
+        }
+
+        /**
+         * @brief Mark the end of the game logic of the current frame
+         *
+         */
+        void logic_done() {
+            logic_end = now();
+
+            const uint32_t time = uint32_t(logic_end - frame_start);
+
+            stats.logic_total += time;
+
+            if (time > stats.logic_max) {
+                stats.logic_max = time;
+            }
+        }
+
+        /**
+         * @brief Mark the end of drawing the current frame
+         *
+         */
+        void render_done() {
+            const uint64_t end = now();
+            const uint32_t time = uint32_t(end - logic_end);
+
+            frame_time = uint32_t(end - frame_start);
+
+            stats.render_total += time;
+
+            if (time > stats.render_max) {
+                stats.render_max = time;
+            }
+        }
+
+        /**
+         * @brief Get the timing of the frames
+         *
+         * @return const frame_stats&
+         */
+        const frame_stats &get_stats() const {
+            return stats;
+        }
+
+        /**
+         * @brief Get the time between the start of the last two frames
+         *
+         * @return uint32_t
+         */
+        uint32_t get_interval() const {
+            return interval;
+        }
+
+        /**
+         * @brief Get the time from the start to the end of drawing of the
+         * last frame
+         *
+         * @return uint32_t
+         */
+        uint32_t get_frame_time() const {
+            return frame_time;
+        }
+
+        /**
+         * @brief Convert ns to us
+         *
+         * @param ticks
+         * @return uint32_t
+         */
+        constexpr static uint32_t to_us(const uint64_t ticks) {
+            return uint32_t(ticks / 1'000);
+        }
+};
+
+#endif
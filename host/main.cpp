@@ -0,0 +1,222 @@
+#include <hwlib.hpp>
+#include <stdio.h>
+
+#include "spi_bus_recorder.hpp"
+#include "hwlib_ssd1351_buffered.hpp"
+
+/**
+ * @brief Count the pixels on the panel that are not the expected color
+ *
+ * @tparam T
+ * @param display the emulated display
+ * @param expected function that returns the expected rgb565 color of a pixel
+ * @return int amount of wrong pixels
+ */
+template <typename T>
+int wrong_pixels(const ssd1351_emulator & display, T expected) {
+    int wrong = 0;
+
+    for (uint8_t y = 0; y < ssd1351_emulator::height; y++) {
+        for (uint8_t x = 0; x < ssd1351_emulator::width; x++) {
+            if (display.pixel(x, y) != expected(x, y)) {
+                wrong++;
+            }
+        }
+    }
+
+    return wrong;
+}
+
+/**
+ * @brief Print the traffic of a step and the amount of wrong pixels
+ *
+ * @param name name of the step
+ * @param bus the bus to the display
+ * @param dc the data/command pin of the display
+ * @param display the emulated display
+ * @param wrong amount of pixels that are not the expected color
+ * @return int the amount of wrong pixels
+ */
+int print_step(const char *name, const spi_bus_recorder & bus, const host_pin & dc,
+                const ssd1351_emulator & display, const int wrong) {
+    const auto &count = display.get_counters();
+
+    hwlib::cout << name
+                << " bytes: " << int(bus.bytes)
+                << " transactions: " << int(bus.transactions)
+                << " dc toggles: " << int(dc.toggles)
+                << " address commands: " << int(count.address_commands)
+                << " redundant: " << int(count.redundant_address_commands)
+                << " pixels: " << int(count.pixels)
+                << " wrong: " << wrong << "\n";
+
+    return wrong;
+}
+
+/**
+ * @brief Write the panel to a binary ppm image
+ *
+ * @param display the emulated display
+ * @param name file name of the image
+ */
+void write_ppm(const ssd1351_emulator & display, const char *name) {
+    FILE *file = fopen(name, "wb");
+
+    if (!file) {
+        return;
+    }
+
+    fprintf(file, "P6\n%d %d\n255\n", ssd1351_emulator::width, ssd1351_emulator::height);
+
+    for (uint8_t y = 0; y < ssd1351_emulator::height; y++) {
+        for (uint8_t x = 0; x < ssd1351_emulator::width; x++) {
+            const uint16_t value = display.pixel(x, y);
+
+            // expand the 5 and 6 bit colors to 8 bits
+            const uint8_t rgb[] = {
+                uint8_t(((value >> 11) & 0x1F) * 0xFF / 0x1F),
+                uint8_t(((value >> 5) & 0x3F) * 0xFF / 0x3F),
+                uint8_t((value & 0x1F) * 0xFF / 0x1F)
+            };
+
+            fwrite(rgb, sizeof(rgb), 1, file);
+        }
+    }
+
+    fclose(file);
+}
+
+int main() {
+    // the emulated display and the pins that are connected to it
+    auto panel = ssd1351_emulator();
+    auto reset = host_pin(true);
+    auto dc = host_pin();
+    auto cs = host_pin(true);
+
+    // bus that sends everything to the emulated display
+    auto bus = spi_bus_recorder(panel, dc);
+
+    // the same display object the game uses
+    auto display = hwlib_ssd1351_buffered(bus, reset, dc, cs);
+
+    // amount of wrong pixels of all the steps
+    int wrong = print_step("init", bus, dc, panel, 0);
+
+    // clear the whole screen to red
+    bus.reset();
+    display.fill_rect(hwlib::location(0, 0), hwlib::location(128, 128), color565::red);
+    display.flush();
+
+    wrong += print_step("fill", bus, dc, panel, wrong_pixels(panel, [](uint8_t x, uint8_t y) {
+        return color565::red.value;
+    }));
+
+    // draw a single green rectangle on the red screen
+    bus.reset();
+    display.fill_rect(hwlib::location(10, 20), hwlib::location(30, 4), color565::green);
+    display.flush();
+
+    wrong += print_step("rect", bus, dc, panel, wrong_pixels(panel, [](uint8_t x, uint8_t y) {
+        const bool inside = x >= 10 && x < 40 && y >= 20 && y < 24;
+
+        return inside ? color565::green.value : color565::red.value;
+    }));
+
+    // write single pixels on a diagonal
+    bus.reset();
+
+    for (uint8_t i = 0; i < 128; i += 8) {
+        display.write(hwlib::location(i, i), color565::white);
+    }
+
+    display.flush();
+
+    wrong += print_step("pixels", bus, dc, panel, wrong_pixels(panel, [](uint8_t x, uint8_t y) {
+        const bool inside = x >= 10 && x < 40 && y >= 20 && y < 24;
+
+        if (x == y && !(x % 8)) {
+            return color565::white.value;
+        }
+
+        return inside ? color565::green.value : color565::red.value;
+    }));
+
+    // write a rectangle and a fill that are partly off the screen. Only the
+    // part on the screen may change
+    bus.reset();
+
+    uint8_t data[8 * 8 * 2];
+
+    for (auto &value : data) {
+        value = 0xFF;
+    }
+
+    display.write_rect(hwlib::location(124, -4), hwlib::location(8, 8), data);
+    display.fill_rect(hwlib::location(-4, 124), hwlib::location(8, 8), color565::blue);
+    display.write(hwlib::location(128, 0), color565::blue);
+    display.flush();
+
+    wrong += print_step("clip", bus, dc, panel, wrong_pixels(panel, [](uint8_t x, uint8_t y) {
+        const bool inside = x >= 10 && x < 40 && y >= 20 && y < 24;
+
+        if (x >= 124 && y < 4) {
+            return color565::white.value;
+        }
+
+        if (x < 4 && y >= 124) {
+            return color565::blue.value;
+        }
+
+        if (x == y && !(x % 8)) {
+            return color565::white.value;
+        }
+
+        return inside ? color565::green.value : color565::red.value;
+    }));
+
+    // store the result so it can be compared by eye
+    write_ppm(panel, "screen.ppm");
+
+    // the window without a framebuffer clips the same way. Every pixel of the
+    // rectangle has a different color so a wrong offset in the data shows
+    auto direct = hwlib_ssd1351_t<ssd1351_t<spi_bus_recorder, host_pin, host_pin, host_pin>>(
+        bus, reset, dc, cs
+    );
+
+    direct.fill_rect(hwlib::location(0, 0), hwlib::location(128, 128), color565::red);
+    bus.reset();
+
+    for (uint8_t i = 0; i < 8 * 8; i++) {
+        data[i * 2] = 0;
+        data[i * 2 + 1] = i + 1;
+    }
+
+    direct.write_rect(hwlib::location(124, -4), hwlib::location(8, 8), data);
+    direct.fill_rect(hwlib::location(-4, 124), hwlib::location(8, 8), color565::blue);
+    direct.fill_rect(hwlib::location(10, 10), hwlib::location(0, 8), color565::green);
+    direct.write(hwlib::location(-1, 0), color565::green);
+    direct.flush();
+
+    wrong += print_step("direct clip", bus, dc, panel, wrong_pixels(panel, [](uint8_t x, uint8_t y) {
+        if (x >= 124 && y < 4) {
+            return uint16_t((y + 4) * 8 + (x - 124) + 1);
+        }
+
+        if (x < 4 && y >= 124) {
+            return color565::blue.value;
+        }
+
+        return color565::red.value;
+    }));
+
+    // fail the run when a step did not show what was written
+    if (wrong) {
+        hwlib::cout << "FAIL: " << wrong << " wrong pixels\n";
+
+        return 1;
+    }
+
+    hwlib::cout << "PASS\n";
+
+    return 0;
+}
@@ -0,0 +1,169 @@
+#ifndef SPI_BUS_RECORDER_HPP
+#define SPI_BUS_RECORDER_HPP
+
+#include <hwlib.hpp>
+#include "spi_bus_extended.hpp"
+#include "ssd1351_emulator.hpp"
+
+/**
+ * @brief Output pin on a host that remembers its level
+ *
+ */
+class host_pin : public hwlib::pin_out {
+    public:
+        // current level of the pin
+        bool level;
+
+        // amount of times the level changed
+        uint32_t toggles;
+
+        /**
+         * @brief Construct a new host pin
+         *
+         * @param level start level of the pin
+         */
+        host_pin(const bool level = false):
+            level(level), toggles(0)
+        {}
+
+        void set(bool value, hwlib::buffering buf = hwlib::buffering::unbuffered) override {
+            if (value != level) {
+                toggles++;
+            }
+
+            level = value;
+        }
+};
+
+/**
+ * @brief Spi bus on a host that sends everything to a ssd1351 emulator
+ *
+ * @details Uses the level of the data/command pin to split the commands from
+ * the data. Every call on the bus is counted as a single transaction, the
+ * same as the dma and 16 bit paths of the hardware bus, so the numbers match
+ * spi_bus_counter on the device.
+ *
+ */
+class spi_bus_recorder : public spi_bus_extended {
+    protected:
+        // display that receives the bytes
+        ssd1351_emulator & display;
+
+        // data/command pin of the display
+        host_pin & dc;
+
+        /**
+         * @brief Send a byte to the display
+         *
+         * @param value
+         */
+        void send(const uint8_t value) {
+            display.write(value, dc.level);
+        }
+
+    public:
+        // amount of bytes on the spi bus
+        uint32_t bytes;
+
+        // amount of calls on the spi bus
+        uint32_t transactions;
+
+        /**
+         * @brief Construct a new spi bus recorder
+         *
+         * @param display the display that receives the bytes
+         * @param dc the data/command pin of the display
+         */
+        spi_bus_recorder(ssd1351_emulator & display, host_pin & dc):
+            display(display), dc(dc), bytes(0), transactions(0)
+        {}
+
+        /**
+         * @brief Reset the counters of the bus, the data/command pin and the
+         * display
+         *
+         */
+        void reset() {
+            bytes = 0;
+            transactions = 0;
+            dc.toggles = 0;
+
+            display.reset_counters();
+        }
+
+        void write_and_read(hwlib::pin_out & cs, const size_t amount, const uint8_t *data_out,
+                            uint8_t *data_in) override {
+            bytes += amount;
+            transactions++;
+
+            for (size_t i = 0; i < amount; i++) {
+                send(data_out ? data_out[i] : 0);
+
+                // the display does not send anything back
+                if (data_in) {
+                    data_in[i] = 0;
+                }
+            }
+        }
+
+        void write_repeat(hwlib::pin_out & cs, const size_t amount, const uint8_t *pattern,
+                          const size_t count) override {
+            bytes += amount * count;
+            transactions++;
+
+            for (size_t i = 0; i < count; i++) {
+                for (size_t j = 0; j < amount; j++) {
+                    send(pattern[j]);
+                }
+            }
+        }
+
+        void write_repeat16(hwlib::pin_out & cs, const uint16_t word, const size_t count) override {
+            bytes += count * 2;
+            transactions++;
+
+            // high byte first
+            for (size_t i = 0; i < count; i++) {
+                send(uint8_t(word >> 8));
+                send(uint8_t(word & 0xFF));
+            }
+        }
+
+        void write_lines_async(hwlib::pin_out & cs, const size_t amount, const uint8_t *data,
+                               const size_t stride, const size_t lines,
+                               void (*callback)() = nullptr) override {
+            bytes += amount * lines;
+            transactions++;
+
+            for (size_t i = 0; i < lines; i++) {
+                for (size_t j = 0; j < amount; j++) {
+                    send(data[i * stride + j]);
+                }
+            }
+
+            if (callback) {
+                callback();
+            }
+        }
+
+        void write_lines16_async(hwlib::pin_out & cs, const size_t amount, const uint16_t *data,
+                                 const size_t stride, const size_t lines,
+                                 void (*callback)() = nullptr) override {
+            bytes += amount * lines * 2;
+            transactions++;
+
+            // high byte first
+            for (size_t i = 0; i < lines; i++) {
+                for (size_t j = 0; j < amount; j++) {
+                    send(uint8_t(data[i * stride + j] >> 8));
+                    send(uint8_t(data[i * stride + j] & 0xFF));
+                }
+            }
+
+            if (callback) {
+                callback();
+            }
+        }
+};
+
+#endif
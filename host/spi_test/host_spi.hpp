@@ -0,0 +1,254 @@
+#ifndef HOST_SPI_HPP
+#define HOST_SPI_HPP
+
+#include <stdint.h>
+#include <stddef.h>
+#include <vector>
+
+// the bits of the sam3x8e spi and pdc registers that are used by spi_pdc
+#define SPI_CR_LASTXFER (0x1u << 24)
+#define SPI_SR_RDRF (0x1u << 0)
+#define SPI_SR_TDRE (0x1u << 1)
+#define SPI_SR_ENDTX (0x1u << 5)
+#define SPI_SR_TXEMPTY (0x1u << 9)
+#define SPI_IER_ENDTX SPI_SR_ENDTX
+#define SPI_IER_TXEMPTY SPI_SR_TXEMPTY
+#define SPI_IDR_ENDTX SPI_SR_ENDTX
+#define SPI_IDR_TXEMPTY SPI_SR_TXEMPTY
+#define SPI_CSR_SCBR_Msk (0xffu << 8)
+#define SPI_CSR_SCBR(value) ((SPI_CSR_SCBR_Msk & ((value) << 8)))
+#define SPI_CSR_BITS_Msk (0xfu << 4)
+#define SPI_CSR_BITS_8_BIT (0x0u << 4)
+#define SPI_CSR_BITS_16_BIT (0x8u << 4)
+#define SPI_PCS(value) ((0xfu << 16) & ((value) << 16))
+#define PERIPH_PTCR_TXTEN (0x1u << 8)
+#define PERIPH_PTCR_TXTDIS (0x1u << 9)
+
+class host_spi;
+
+/**
+ * @brief A register of the spi stand-in
+ *
+ * @details Every write is passed to the stand-in so it can act on it like the
+ * hardware does. Big enough to store a pointer of the host.
+ *
+ */
+class host_register {
+    protected:
+        // the stand-in with the register
+        host_spi *spi;
+
+    public:
+        // the value in the register
+        uintptr_t value;
+
+        host_register(host_spi *spi):
+            spi(spi), value(0)
+        {}
+
+        host_register &operator=(const uintptr_t data);
+
+        operator uintptr_t() const;
+};
+
+/**
+ * @brief Stand-in for the spi and pdc registers of the sam3x8e on a host
+ *
+ * @details Records every transfer with the level of the data/command pin. A
+ * transfer is done the moment it is written to the transmit register. The pdc
+ * writes a whole buffer every step and moves to the next buffer like the
+ * hardware, so the interrupt handler can be tested without a due.
+ *
+ */
+class host_spi {
+    public:
+        /**
+         * @brief A byte on the bus or the release of the chip select
+         *
+         */
+        struct transfer {
+            // the byte. -1 when the chip select is released
+            int value;
+
+            // level of the data/command pin during the byte
+            bool dc;
+        };
+
+        // the registers that are used by spi_pdc
+        host_register SPI_CR{this};
+        host_register SPI_RDR{this};
+        host_register SPI_TDR{this};
+        host_register SPI_SR{this};
+        host_register SPI_IER{this};
+        host_register SPI_IDR{this};
+        host_register SPI_IMR{this};
+        host_register SPI_CSR[4]{{this}, {this}, {this}, {this}};
+        host_register SPI_TPR{this};
+        host_register SPI_TCR{this};
+        host_register SPI_TNPR{this};
+        host_register SPI_TNCR{this};
+        host_register SPI_PTCR{this};
+
+        // everything that is written on the bus
+        std::vector<transfer> transfers;
+
+        // amount of times the pdc ran out of buffers while it was enabled
+        uint32_t stops = 0;
+
+        // level of the data/command pin. nullptr when there is no pin
+        const bool *dc = nullptr;
+
+        // called when a enabled interrupt is pending
+        void (*handler)() = nullptr;
+
+        // if the interrupt is enabled
+        bool interrupt = true;
+
+    protected:
+        // if the pdc is allowed to transfer
+        bool tx_enabled = false;
+
+        // if the current buffer of the pdc ended (the ENDTX flag)
+        bool end_of_buffer = false;
+
+        /**
+         * @brief Record a transfer in 8 or 16 bits
+         *
+         * @param data
+         */
+        void send(const uint16_t data) {
+            const bool level = dc ? *dc : false;
+
+            // 16 bit transfers send the high byte first
+            if ((SPI_CSR[0].value & SPI_CSR_BITS_Msk) == SPI_CSR_BITS_16_BIT) {
+                transfers.push_back({data >> 8, level});
+            }
+
+            transfers.push_back({data & 0xff, level});
+        }
+
+    public:
+        /**
+         * @brief Get the status register
+         *
+         * @return uint32_t
+         */
+        uint32_t status() const {
+            uint32_t result = SPI_SR_RDRF;
+
+            // the bus is only busy while the pdc has something to send
+            if (!tx_enabled || SPI_TCR.value == 0) {
+                result |= SPI_SR_TDRE | SPI_SR_TXEMPTY;
+            }
+
+            if (end_of_buffer) {
+                result |= SPI_SR_ENDTX;
+            }
+
+            return result;
+        }
+
+        /**
+         * @brief Handle a write to a register
+         *
+         * @param reg the register that is written
+         * @param data
+         */
+        void write(host_register &reg, const uintptr_t data) {
+            if (&reg == &SPI_CR) {
+                // mark the release of the chip select in the transfers
+                if (data & SPI_CR_LASTXFER) {
+                    transfers.push_back({-1, dc ? *dc : false});
+                }
+            }
+            else if (&reg == &SPI_TDR) {
+                send(uint16_t(data));
+            }
+            else if (&reg == &SPI_IER) {
+                SPI_IMR.value |= data;
+            }
+            else if (&reg == &SPI_IDR) {
+                SPI_IMR.value &= ~data;
+            }
+            else if (&reg == &SPI_PTCR) {
+                if (data & PERIPH_PTCR_TXTEN) {
+                    tx_enabled = true;
+                }
+
+                if (data & PERIPH_PTCR_TXTDIS) {
+                    tx_enabled = false;
+                }
+            }
+            else {
+                reg.value = data;
+
+                // a new counter clears the end of the buffer
+                if ((&reg == &SPI_TCR || &reg == &SPI_TNCR) && data) {
+                    end_of_buffer = false;
+                }
+            }
+        }
+
+        /**
+         * @brief Run the interrupt when it is pending or let the pdc send a buffer
+         *
+         * @return true when something happened
+         * @return false when the spi is idle
+         */
+        bool step() {
+            // the interrupt goes first like on the hardware
+            if (interrupt && handler && (status() & SPI_IMR.value)) {
+                handler();
+
+                return true;
+            }
+
+            if (!tx_enabled || SPI_TCR.value == 0) {
+                return false;
+            }
+
+            // send the current buffer
+            const bool words = (SPI_CSR[0].value & SPI_CSR_BITS_Msk) == SPI_CSR_BITS_16_BIT;
+
+            for (uintptr_t i = 0; i < SPI_TCR.value; i++) {
+                if (words) {
+                    send(reinterpret_cast<const uint16_t*>(SPI_TPR.value)[i]);
+                }
+                else {
+                    send(reinterpret_cast<const uint8_t*>(SPI_TPR.value)[i]);
+                }
+            }
+
+            SPI_TCR.value = 0;
+            end_of_buffer = true;
+
+            // move to the next buffer. The pdc stops when there is none
+            if (SPI_TNCR.value) {
+                SPI_TPR.value = SPI_TNPR.value;
+                SPI_TCR.value = SPI_TNCR.value;
+                SPI_TNCR.value = 0;
+            }
+            else {
+                stops++;
+            }
+
+            return true;
+        }
+};
+
+inline host_register &host_register::operator=(const uintptr_t data) {
+    spi->write(*this, data);
+
+    return *this;
+}
+
+inline host_register::operator uintptr_t() const {
+    // the status is made from the state of the stand-in
+    if (this == &spi->SPI_SR) {
+        return spi->status();
+    }
+
+    return value;
+}
+
+#endif
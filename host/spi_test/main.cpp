@@ -0,0 +1,381 @@
+#include <hwlib.hpp>
+#include <vector>
+
+#include "host_spi.hpp"
+#include "spi_pdc.hpp"
+
+// the stand-in for SPI0
+host_spi spi0;
+
+/**
+ * @brief The registers of the stand-in for spi_pdc
+ *
+ */
+struct host_registers {
+    static host_spi *spi() {
+        return &spi0;
+    }
+
+    static void interrupt(const bool enable) {
+        spi0.interrupt = enable;
+    }
+};
+
+/**
+ * @brief The transfers on the stand-in with access to the state
+ *
+ */
+class pdc : public spi_pdc<host_registers> {
+    public:
+        using spi_pdc<host_registers>::busy;
+        using spi_pdc<host_registers>::queue;
+};
+
+/**
+ * @brief Data/command pin that is read by the stand-in
+ *
+ */
+class test_pin : public hwlib::pin_out {
+    public:
+        // current level of the pin
+        bool level = false;
+
+        void set(bool value, hwlib::buffering buf = hwlib::buffering::unbuffered) override {
+            level = value;
+        }
+};
+
+// the data/command pin of the queued transactions
+test_pin dc;
+
+// set by the callback of the asynchronous writes
+bool called = false;
+
+/**
+ * @brief Callback of the asynchronous writes
+ *
+ */
+void done() {
+    called = true;
+}
+
+/**
+ * @brief Let the pdc and the interrupt run until the spi is idle
+ *
+ */
+void run() {
+    // stop when the writes never end
+    for (uint32_t i = 0; i < 100'000 && spi0.step(); i++) {}
+}
+
+/**
+ * @brief Clear the transfers of the stand-in before a step
+ *
+ */
+void start_step() {
+    spi0.transfers.clear();
+    spi0.stops = 0;
+    called = false;
+}
+
+/**
+ * @brief Compare the transfers with the expected bytes and print the step
+ *
+ * @param name name of the step
+ * @param expected the expected bytes. -1 for the release of the chip select
+ * @param stops the amount of times the pdc should run out of buffers
+ * @param callback if the callback should be called
+ * @return int the amount of wrong transfers
+ */
+int check_step(const char *name, const std::vector<int> &expected, const uint32_t stops,
+               const bool callback) {
+    int wrong = 0;
+
+    for (size_t i = 0; i < expected.size() || i < spi0.transfers.size(); i++) {
+        if (i >= expected.size() || i >= spi0.transfers.size() ||
+            spi0.transfers[i].value != expected[i]) {
+            wrong++;
+        }
+    }
+
+    // a pdc that stops between the lines or a missing callback is wrong as well
+    if (spi0.stops != stops || called != callback || pdc::busy) {
+        wrong++;
+    }
+
+    hwlib::cout << name
+                << " transfers: " << int(spi0.transfers.size())
+                << " stops: " << int(spi0.stops)
+                << " wrong: " << wrong << "\n";
+
+    return wrong;
+}
+
+/**
+ * @brief Create a transaction with the data in the transaction
+ *
+ * @param level level of the data/command pin
+ * @param value the byte to write
+ * @param release_cs release the chip select after the byte
+ * @return spi_transaction
+ */
+spi_transaction inline_byte(const bool level, const uint8_t value, const bool release_cs) {
+    spi_transaction transaction = {};
+
+    transaction.dc = &dc;
+    transaction.dc_level = level;
+    transaction.size = 1;
+    transaction.lines = 1;
+    transaction.release_cs = release_cs;
+    transaction.inline_data[0] = value;
+
+    return transaction;
+}
+
+/**
+ * @brief Test the queue with a interrupt that only runs when asked
+ *
+ * @details Checks the order, the wrap around of the positions and that a push
+ * fails when the queue is full
+ *
+ * @return int the amount of wrong items
+ */
+int queue_step() {
+    spi_queue<4> queue;
+    std::vector<uint32_t> drained;
+    int wrong = 0;
+
+    // the tx interrupt writes the front transaction and removes it
+    auto tx_interrupt = [&]() {
+        const spi_transaction *front = queue.front();
+
+        if (front) {
+            drained.push_back(front->lines);
+            queue.pop();
+        }
+    };
+
+    spi_transaction transaction = {};
+    uint32_t pushed = 0;
+
+    // fill the queue and drain a part of it a few times so the positions wrap
+    for (uint8_t round = 0; round < 5; round++) {
+        // one slot is always free
+        for (uint8_t i = 0; i < 3; i++) {
+            transaction.lines = pushed;
+
+            if (queue.push(transaction)) {
+                pushed++;
+            }
+        }
+
+        transaction.lines = pushed;
+
+        if (queue.push(transaction)) {
+            wrong++;
+        }
+
+        tx_interrupt();
+        tx_interrupt();
+    }
+
+    // drain the rest
+    while (!queue.empty()) {
+        tx_interrupt();
+    }
+
+    // every transaction comes out once in the order it went in
+    for (uint32_t i = 0; i < drained.size() || i < pushed; i++) {
+        if (i >= drained.size() || drained[i] != i) {
+            wrong++;
+        }
+    }
+
+    hwlib::cout << "queue"
+                << " pushed: " << int(pushed)
+                << " drained: " << int(drained.size())
+                << " wrong: " << wrong << "\n";
+
+    return wrong;
+}
+
+int main() {
+    int wrong = 0;
+
+    spi0.handler = pdc::interrupt_handler;
+    pdc::set_profiles(21);
+
+    // bytes written without the pdc
+    start_step();
+
+    const uint8_t command[] = {0x15, 0x00, 0x7f};
+    pdc::write_bytes(command, sizeof(command));
+
+    wrong += check_step("write bytes", {0x15, 0x00, 0x7f}, 0, false);
+
+    // a single line only uses the current buffer
+    start_step();
+
+    const uint8_t line[] = {1, 2, 3};
+    pdc::start_lines(line, sizeof(line), 0, 1, done, false);
+    run();
+
+    wrong += check_step("single line", {1, 2, 3}, 1, true);
+
+    // lines from a bigger buffer. The next line is always loaded so the pdc
+    // only stops after the last line
+    start_step();
+
+    const uint8_t lines[] = {
+        0x10, 0x11, 0x12, 0x13, 0xee, 0xee,
+        0x20, 0x21, 0x22, 0x23, 0xee, 0xee,
+        0x30, 0x31, 0x32, 0x33, 0xee, 0xee
+    };
+
+    pdc::start_lines(lines, 4, 6, 3, done, false);
+    run();
+
+    wrong += check_step("8 bit lines", {
+        0x10, 0x11, 0x12, 0x13,
+        0x20, 0x21, 0x22, 0x23,
+        0x30, 0x31, 0x32, 0x33
+    }, 1, true);
+
+    // 16 bit lines send the high byte first and go back to 8 bit transfers
+    start_step();
+
+    const uint16_t words[] = {
+        0x1234, 0xabcd, 0xeeee,
+        0x5678, 0x9abc, 0xeeee
+    };
+
+    pdc::start_lines(reinterpret_cast<const uint8_t*>(words), 2, 3 * 2, 2, done, true);
+    run();
+
+    wrong += check_step("16 bit lines", {
+        0x12, 0x34, 0xab, 0xcd,
+        0x56, 0x78, 0x9a, 0xbc
+    }, 1, true);
+
+    if ((spi0.SPI_CSR[0].value & SPI_CSR_BITS_Msk) != SPI_CSR_BITS_8_BIT) {
+        hwlib::cout << "16 bit transfers after the lines\n";
+        wrong++;
+    }
+
+    wrong += queue_step();
+
+    // queued transactions are written from the interrupt. The chip select is
+    // released after the last byte of a batch
+    spi0.dc = &dc.level;
+    start_step();
+
+    spi_transaction fill = {};
+    const uint16_t color = 0x1234;
+
+    fill.dc = &dc;
+    fill.dc_level = true;
+    fill.words = true;
+    fill.lines = 70;
+    fill.size = 1;
+    fill.release_cs = true;
+    fill.data = &color;
+
+    pdc::enqueue(inline_byte(false, 0x5c, false));
+    pdc::enqueue(fill);
+    pdc::enqueue(inline_byte(false, 0x15, false));
+    pdc::enqueue(inline_byte(true, 0x7f, true));
+    run();
+
+    std::vector<int> expected = {0x5c};
+
+    for (uint8_t i = 0; i < 70; i++) {
+        expected.push_back(0x12);
+        expected.push_back(0x34);
+    }
+
+    expected.insert(expected.end(), {-1, 0x15, 0x7f, -1});
+
+    // the level of the data/command pin of every byte
+    int dc_wrong = 0;
+
+    for (size_t i = 0; i < spi0.transfers.size(); i++) {
+        const bool level = !(i == 0 || i == 142);
+
+        if (spi0.transfers[i].value >= 0 && spi0.transfers[i].dc != level) {
+            dc_wrong++;
+        }
+    }
+
+    wrong += dc_wrong + check_step("queued batches", expected, spi0.stops, false);
+
+    // fill the queue a few times so the positions wrap past the end
+    start_step();
+    expected.clear();
+
+    for (uint8_t round = 0; round < 3; round++) {
+        // the first transaction is started and the others wait in the queue
+        for (uint8_t i = 0; i < pdc::queue_size - 1; i++) {
+            const uint8_t value = round * 16 + i;
+            const bool last = i == pdc::queue_size - 2;
+
+            pdc::enqueue(inline_byte(true, value, last));
+
+            expected.push_back(value);
+        }
+
+        expected.push_back(-1);
+
+        run();
+    }
+
+    wrong += check_step("queue wrap", expected, spi0.stops, false);
+
+    if (!pdc::queue.empty()) {
+        hwlib::cout << "transactions left in the queue\n";
+        wrong++;
+    }
+
+    // a batch that ends with a empty transaction like the flush of the
+    // display. The empty transaction is done right away in the interrupt
+    start_step();
+
+    spi_transaction end = {};
+    end.release_cs = true;
+
+    const uint8_t data[] = {0x01, 0x02, 0x03, 0x04, 0x05};
+
+    spi_transaction write = {};
+    write.dc = &dc;
+    write.dc_level = true;
+    write.size = sizeof(data);
+    write.lines = 1;
+    write.data = data;
+
+    pdc::enqueue(write);
+    pdc::enqueue(end);
+    run();
+
+    wrong += check_step("empty end of batch", {0x01, 0x02, 0x03, 0x04, 0x05, -1}, 1, false);
+
+    // the empty transaction on a idle bus is done in enqueue
+    start_step();
+
+    pdc::enqueue(end);
+
+    wrong += check_step("empty end on idle bus", {-1}, 0, false);
+
+    if (!pdc::queue.empty()) {
+        hwlib::cout << "empty transactions left in the queue\n";
+        wrong++;
+    }
+
+    if (wrong) {
+        hwlib::cout << "FAIL: " << wrong << " wrong transfers\n";
+
+        return 1;
+    }
+
+    hwlib::cout << "PASS\n";
+
+    return 0;
+}
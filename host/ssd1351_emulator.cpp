@@ -0,0 +1,170 @@
+#include "ssd1351_emulator.hpp"
+
+void ssd1351_emulator::reset() {
+    // start with a black screen
+    for (auto &line : ram) {
+        for (auto &value : line) {
+            value = 0;
+        }
+    }
+
+    // the window is the whole display ram
+    column_start = 0;
+    column_end = width - 1;
+    row_start = 0;
+    row_end = height - 1;
+
+    column = 0;
+    row = 0;
+
+    // reset values from the datasheet
+    remap = 0x40;
+    start_line = 0;
+    offset = 0x60;
+    mode = 0xA6;
+
+    command = 0;
+    parameter = 0;
+    first = 0;
+
+    count = {};
+}
+
+void ssd1351_emulator::write(const uint8_t value, const bool dc) {
+    if (dc) {
+        count.data++;
+
+        parameter_byte(value);
+
+        return;
+    }
+
+    count.commands++;
+
+    // the parameters that follow are for this command
+    command = value;
+    parameter = 0;
+
+    // 0xA4 - 0xA7 = display mode without parameters
+    if (value >= 0xA4 && value <= 0xA7) {
+        mode = value;
+    }
+}
+
+void ssd1351_emulator::parameter_byte(const uint8_t value) {
+    switch (command) {
+        case 0x15:
+        case 0x75:
+            // the window is changed when the end is received
+            if (parameter == 0) {
+                first = value;
+            }
+            else if (parameter == 1) {
+                if (command == 0x15) {
+                    set_window(column_start, column_end, column, first, value);
+                }
+                else {
+                    set_window(row_start, row_end, row, first, value);
+                }
+            }
+            break;
+        case 0x5C:
+            // every pixel is send high byte first
+            if (!(parameter & 0x1)) {
+                first = value;
+            }
+            else {
+                write_pixel(uint16_t((first << 8) | value));
+            }
+            break;
+        case 0xA0:
+            remap = value;
+            break;
+        case 0xA1:
+            start_line = value & 0x7F;
+            break;
+        case 0xA2:
+            offset = value & 0x7F;
+            break;
+        default:
+            // does not change what is on the screen
+            break;
+    }
+
+    parameter++;
+}
+
+void ssd1351_emulator::set_window(uint8_t &start, uint8_t &end, uint8_t &cursor,
+                                  const uint8_t first_value, const uint8_t value) {
+    const uint8_t new_start = first_value & 0x7F;
+    const uint8_t new_end = value & 0x7F;
+
+    count.address_commands++;
+
+    // the command only moves the cursor back to the start of the window
+    if (start == new_start && end == new_end && cursor == new_start) {
+        count.redundant_address_commands++;
+    }
+
+    start = new_start;
+    end = new_end;
+    cursor = new_start;
+}
+
+void ssd1351_emulator::write_pixel(const uint16_t value) {
+    ram[row & 0x7F][column & 0x7F] = value;
+    count.pixels++;
+
+    // bit 0 of the remap = vertical address increment
+    if (remap & 0x01) {
+        if (++row > row_end) {
+            row = row_start;
+
+            if (++column > column_end) {
+                column = column_start;
+            }
+        }
+    }
+    else {
+        if (++column > column_end) {
+            column = column_start;
+
+            if (++row > row_end) {
+                row = row_start;
+            }
+        }
+    }
+}
+
+uint16_t ssd1351_emulator::pixel(const uint8_t x, const uint8_t y) const {
+    // 0xA4 = all pixels off, 0xA5 = all pixels on
+    if (mode == 0xA4) {
+        return 0x0000;
+    }
+    if (mode == 0xA5) {
+        return 0xFFFF;
+    }
+
+    // bit 1 of the remap = column 127 is mapped to SEG0
+    const uint8_t seg = (remap & 0x02) ? (width - 1) - (x & 0x7F) : (x & 0x7F);
+
+    // bit 4 of the remap = scan from COM[n-1] to COM0
+    const uint8_t com = (remap & 0x10) ? (y & 0x7F) : (height - 1) - (y & 0x7F);
+
+    // the offset moves the rows on the panel and the start line moves the
+    // first row of the display ram
+    uint16_t value = ram[(com - offset + start_line) & 0x7F][seg];
+
+    // bit 2 of the remap = color sequence C -> B -> A. Without it red and
+    // blue are swapped
+    if (!(remap & 0x04)) {
+        value = uint16_t((value & 0x07E0) | (value >> 11) | ((value & 0x1F) << 11));
+    }
+
+    // 0xA7 = inverse display
+    if (mode == 0xA7) {
+        value = uint16_t(~value);
+    }
+
+    return value;
+}
@@ -0,0 +1,172 @@
+#ifndef SSD1351_EMULATOR_HPP
+#define SSD1351_EMULATOR_HPP
+
+#include <stdint.h>
+#include <stddef.h>
+
+/**
+ * @brief Decoder for the command stream of a ssd1351 that keeps the display ram
+ *
+ * @details Runs on a host. The bytes that are send with the data/command pin
+ * low are decoded as commands and the bytes with the pin high as parameters
+ * or as pixels after a 0x5C. Only the commands that change what is on the
+ * screen are decoded: the column and row window (0x15/0x75), the ram writes
+ * (0x5C), the remap (0xA0), the start line (0xA1), the offset (0xA2) and the
+ * display mode (0xA4 - 0xA7). The parameters of all the other commands are
+ * ignored. Only the 65k color formats are decoded.
+ *
+ */
+class ssd1351_emulator {
+    public:
+        // height and width of the display ram
+        constexpr static uint8_t height = 128;
+        constexpr static uint8_t width = 128;
+
+        /**
+         * @brief Traffic of the display since the last reset of the counters
+         *
+         */
+        struct counters {
+            // amount of command bytes
+            uint32_t commands;
+
+            // amount of parameter and pixel bytes
+            uint32_t data;
+
+            // amount of pixels written to the display ram
+            uint32_t pixels;
+
+            // amount of 0x15 and 0x75 commands
+            uint32_t address_commands;
+
+            // amount of 0x15 and 0x75 commands that did not change the
+            // window or the cursor
+            uint32_t redundant_address_commands;
+        };
+
+    protected:
+        // the display ram in rgb565 with the row as the first index
+        uint16_t ram[height][width];
+
+        // the window of the ram writes
+        uint8_t column_start;
+        uint8_t column_end;
+        uint8_t row_start;
+        uint8_t row_end;
+
+        // position of the next pixel in the window
+        uint8_t column;
+        uint8_t row;
+
+        // settings of 0xA0, 0xA1, 0xA2 and 0xA4 - 0xA7
+        uint8_t remap;
+        uint8_t start_line;
+        uint8_t offset;
+        uint8_t mode;
+
+        // last command and the amount of parameters received for it
+        uint8_t command;
+        uint8_t parameter;
+
+        // first parameter of a window command or the high byte of a pixel
+        uint8_t first;
+
+        // traffic of the display
+        counters count;
+
+        /**
+         * @brief Handle a parameter of the last command
+         *
+         * @param value
+         */
+        void parameter_byte(const uint8_t value);
+
+        /**
+         * @brief Set the window and the cursor of a single direction
+         *
+         * @param start start of the window
+         * @param end end of the window
+         * @param cursor cursor of the direction. Moved to the start
+         * @param first_value new start
+         * @param value new end
+         */
+        void set_window(uint8_t &start, uint8_t &end, uint8_t &cursor,
+                        const uint8_t first_value, const uint8_t value);
+
+        /**
+         * @brief Write a pixel on the cursor and move the cursor
+         *
+         * @param value
+         */
+        void write_pixel(const uint16_t value);
+
+    public:
+        /**
+         * @brief Construct a new emulator with the reset state of the display
+         *
+         */
+        ssd1351_emulator() {
+            reset();
+        }
+
+        /**
+         * @brief Set the display to the state after a hardware reset
+         *
+         * @details The display ram is not cleared by a reset on the hardware.
+         * The emulator clears it to black so every run starts the same.
+         *
+         */
+        void reset();
+
+        /**
+         * @brief Reset the traffic counters
+         *
+         */
+        void reset_counters() {
+            count = {};
+        }
+
+        /**
+         * @brief Handle a byte on the spi bus
+         *
+         * @param value
+         * @param dc level of the data/command pin. false for a command
+         */
+        void write(const uint8_t value, const bool dc);
+
+        /**
+         * @brief Get a pixel of the display ram
+         *
+         * @param column
+         * @param row
+         * @return uint16_t rgb565
+         */
+        uint16_t ram_pixel(const uint8_t column, const uint8_t row) const {
+            return ram[row & 0x7F][column & 0x7F];
+        }
+
+        /**
+         * @brief Get a pixel as it is shown on the panel
+         *
+         * @details Applies the remap, the start line, the offset and the
+         * display mode. The panel on the module is mounted so the settings
+         * of hwlib_ssd1351 (scan from COM[n-1] to COM0 and color sequence
+         * C -> B -> A) show the ram upright with red in the high bits.
+         *
+         * @param x
+         * @param y
+         * @return uint16_t rgb565
+         */
+        uint16_t pixel(const uint8_t x, const uint8_t y) const;
+
+        /**
+         * @brief Get the traffic of the display
+         *
+         * @return const counters&
+         */
+        const counters &get_counters() const {
+            return count;
+        }
+};
+
+#endif
@@ -2,7 +2,8 @@
 
 #include "snake.hpp"
 #include "hwspi.hpp"
-#include "hwlib_ssd1351.hpp"
+#include "due_pin.hpp"
+#include "hwlib_ssd1351_buffered.hpp"
 
 int main() {
     // kill the watchdog (ATSAM3X8E specific)
@@ -11,20 +12,40 @@ int main() {
     // Update the cpu frequency by sleeping (hwlib thing)
     hwlib::wait_ms(1);
 
-    // create the reset output
-    auto reset = hwlib::target::pin_out(hwlib::target::pins::d8);
+    // create the reset output. Setting it is a single store to the port
+    auto reset = due::d8();
     
-    // create the data/command output
-    auto dc = hwlib::target::pin_out(hwlib::target::pins::d9);
+    // create the data/command output. Setting it is a single store to the port
+    auto dc = due::d9();
     
-    // create the chipselect
-    auto cs = hwlib::target::pin_out(hwlib::target::pins::d10);
+    // the chip select is npcs0 on D10 and is driven by the spi hardware. D10
+    // is not used as a gpio, a low gpio would keep the chip select asserted
+    auto cs = hwspi_cs();
 
     // create the hardware spi bus at 84/5 = 16.8mhz
     auto bus = hwspi(5);
 
-    // create the display object from the pins and spi bus
-    auto display = hwlib_ssd1351(bus, reset, dc, cs);
+    // use 84/21 = 4mhz for the init sequence and the commands
+    bus.set_divider(spi_profile::command, 21);
+
+#ifdef SNAKE_HUD
+    // count the bytes of every frame for the hud
+    auto counter = spi_bus_counter(bus);
+
+    // create the display object from the pins and the counter. All the 
+    // writes are buffered and send to the screen on a flush
+    auto display = hwlib_ssd1351_buffered_t<
+        ssd1351_t<spi_bus_counter, due::d9, hwspi_cs, due::d8>
+    >(counter, reset, dc, cs);
+#else
+    // create the display object from the pins and spi bus. The bus and the 
+    // pins are bound at compile time so every byte push and pin change is a
+    // direct call. All the writes are buffered and send to the screen on a 
+    // flush
+    auto display = hwlib_ssd1351_buffered_t<
+        ssd1351_t<hwspi, due::d9, hwspi_cs, due::d8>
+    >(bus, reset, dc, cs);
+#endif
 
     // set the fore/background
     display.foreground = hwlib::white;
@@ -33,15 +54,23 @@ int main() {
     // clear the display using the background
     display.clear();
 
-    // create the buttons for the user input
-    auto left_button = hwlib::target::pin_in(hwlib::target::pins::d4);
-    auto right_button = hwlib::target::pin_in(hwlib::target::pins::d3);    
-    
-    // create a port from multiple buttons
-    auto buttons = hwlib::port_in_from_pins(left_button, right_button);
+    // send the cleared framebuffer to the display
+    display.flush();
+
+    // create the interrupt driven buttons on d4 (left) and d3 (right)
+    auto buttons = due_buttons();
+
+#ifdef SNAKE_HUD
+    // create the game above a line at the bottom of the screen for the hud
+    auto snake = game::snake<32, 30, 128, 120>(display, buttons);
 
+    // show the timing of every frame below the game
+    auto hud = perf_hud(display, hwlib::location(2, 122), &counter);
+    snake.show_hud(hud);
+#else
     // create the game 
-    auto snake = game::snake(display, buttons);
+    auto snake = game::snake<32, 32, 128, 128>(display, buttons);
+#endif
 
     // run the snake game
     snake.run();
@@ -0,0 +1,109 @@
+#ifndef DRAW_QUEUE_HPP
+#define DRAW_QUEUE_HPP
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "snake_logic.hpp"
+
+namespace game {
+/**
+ * @brief Queue of the changed positions of a frame
+ *
+ * @details A position that changes more than once in a frame is only stored
+ * once with the last value. On a flush the positions are sorted and the
+ * horizontally adjacent positions with the same value are given to the
+ * renderer as a single run.
+ *
+ * @tparam Width width of the map. Runs do not continue on the next row
+ * @tparam Size maximum amount of different positions in the queue
+ */
+template <uint8_t Width, size_t Size>
+class draw_queue {
+    protected:
+        // the changed positions in the order they are added
+        cell_change changes[Size];
+
+        // amount of changed positions in the queue
+        size_t count = 0;
+
+    public:
+        /**
+         * @brief Add a changed position
+         *
+         * @param change
+         * @return true when the change is added or replaced a change of the
+         * same position
+         * @return false when the queue is full
+         */
+        bool add(const cell_change &change) {
+            // a later change of the same position replaces the earlier change
+            for (size_t i = 0; i < count; i++) {
+                if (changes[i].position == change.position) {
+                    changes[i].value = change.value;
+                    return true;
+                }
+            }
+
+            if (count >= Size) {
+                return false;
+            }
+
+            changes[count++] = change;
+
+            return true;
+        }
+
+        /**
+         * @brief Give all the runs to the renderer and empty the queue
+         *
+         * @tparam F function with a (position, length, value) signature
+         * @param render called once for every run of positions
+         */
+        template <typename F>
+        void flush(F &&render) {
+            // sort the positions. The queue is small so a insertion sort is
+            // faster than anything else
+            for (size_t i = 1; i < count; i++) {
+                const cell_change change = changes[i];
+                size_t j = i;
+
+                for (; j > 0 && changes[j - 1].position > change.position; j--) {
+                    changes[j] = changes[j - 1];
+                }
+
+                changes[j] = change;
+            }
+
+            for (size_t i = 0; i < count;) {
+                size_t end = i + 1;
+
+                // extend the run while the next position is next to the last
+                // one on the same row and has the same value
+                while (end < count &&
+                       changes[end].position == changes[end - 1].position + 1 &&
+                       changes[end].position % Width != 0 &&
+                       changes[end].value == changes[i].value) {
+                    end++;
+                }
+
+                render(changes[i].position, uint8_t(end - i), changes[i].value);
+
+                i = end;
+            }
+
+            count = 0;
+        }
+
+        /**
+         * @brief Get the amount of changed positions in the queue
+         *
+         * @return size_t
+         */
+        size_t size() const {
+            return count;
+        }
+};
+}
+
+#endif
@@ -0,0 +1,116 @@
+#ifndef INDEX_SET_HPP
+#define INDEX_SET_HPP
+
+#include <stdint.h>
+#include <stddef.h>
+
+/**
+ * @brief Set of indexes below a fixed maximum
+ *
+ * @details The indexes are stored in a dense array with the position of every
+ * index next to it. Adding, removing and getting the n-th index are done in
+ * constant time so a random item can be picked without searching.
+ *
+ * @tparam Size amount of possible indexes (0 to Size - 1)
+ */
+template <size_t Size>
+class index_set {
+    protected:
+        // the indexes in the set. Only the first count items are valid
+        uint16_t items[Size];
+
+        // position of every index in the items. Only valid when the index is
+        // in the set
+        uint16_t positions[Size];
+
+        // amount of indexes in the set
+        size_t count;
+
+    public:
+        constexpr index_set():
+            items{}, positions{}, count(0)
+        {}
+
+        /**
+         * @brief Add a index to the set
+         *
+         * @details Does nothing when the index is already in the set
+         *
+         * @param index
+         */
+        void insert(const uint16_t index) {
+            if (contains(index)) {
+                return;
+            }
+
+            // add the index at the end of the dense array
+            items[count] = index;
+            positions[index] = uint16_t(count);
+
+            count++;
+        }
+
+        /**
+         * @brief Remove a index from the set
+         *
+         * @details Does nothing when the index is not in the set
+         *
+         * @param index
+         */
+        void erase(const uint16_t index) {
+            if (!contains(index)) {
+                return;
+            }
+
+            // move the last index in the hole of the removed index
+            const uint16_t position = positions[index];
+            const uint16_t last = items[count - 1];
+
+            items[position] = last;
+            positions[last] = position;
+
+            count--;
+        }
+
+        /**
+         * @brief Check if a index is in the set
+         *
+         * @param index
+         * @return true
+         * @return false
+         */
+        bool contains(const uint16_t index) const {
+            const uint16_t position = positions[index];
+
+            return position < count && items[position] == index;
+        }
+
+        /**
+         * @brief Get the index at a position in the set
+         *
+         * @param position position below the size of the set
+         * @return uint16_t
+         */
+        uint16_t operator[](const size_t position) const {
+            return items[position];
+        }
+
+        /**
+         * @brief Get the amount of indexes in the set
+         *
+         * @return size_t
+         */
+        size_t size() const {
+            return count;
+        }
+
+        /**
+         * @brief Remove all the indexes
+         *
+         */
+        void clear() {
+            count = 0;
+        }
+};
+
+#endif
@@ -0,0 +1,123 @@
+#ifndef PACKED_BOARD_HPP
+#define PACKED_BOARD_HPP
+
+#include <stdint.h>
+#include <stddef.h>
+
+/**
+ * @brief Board with 4 bits for every position
+ *
+ * @details Every position stores a 2 bit type and a 2 bit direction. Eight
+ * positions are packed in a 32 bit word so filling rows and clearing the
+ * board is done a word at a time.
+ *
+ * @tparam Size amount of positions on the board
+ */
+template <size_t Size>
+class packed_board {
+    protected:
+        // amount of positions in a word
+        constexpr static size_t per_word = 8;
+
+        // the packed positions. Bits 0-1 are the type and bits 2-3 the direction
+        uint32_t words[(Size + per_word - 1) / per_word];
+
+        /**
+         * @brief Repeat a 4 bit value in every position of a word
+         *
+         * @param value
+         * @return uint32_t
+         */
+        constexpr static uint32_t repeat(const uint8_t value) {
+            return uint32_t(value & 0xF) * 0x11111111;
+        }
+
+        /**
+         * @brief Get the shift of a position in its word
+         *
+         * @param position
+         * @return uint8_t
+         */
+        constexpr static uint8_t shift(const size_t position) {
+            return uint8_t((position % per_word) * 4);
+        }
+
+    public:
+        constexpr packed_board():
+            words{}
+        {}
+
+        /**
+         * @brief Get the type of a position
+         *
+         * @param position
+         * @return uint8_t
+         */
+        uint8_t type(const size_t position) const {
+            return (words[position / per_word] >> shift(position)) & 0x3;
+        }
+
+        /**
+         * @brief Get the direction of a position
+         *
+         * @param position
+         * @return uint8_t
+         */
+        uint8_t direction(const size_t position) const {
+            return (words[position / per_word] >> (shift(position) + 2)) & 0x3;
+        }
+
+        /**
+         * @brief Set the type and the direction of a position
+         *
+         * @param position
+         * @param type
+         * @param direction
+         */
+        void set(const size_t position, const uint8_t type, const uint8_t direction = 0) {
+            uint32_t &word = words[position / per_word];
+
+            // replace the 4 bits of the position
+            word = (word & ~(uint32_t(0xF) << shift(position))) |
+                   (uint32_t((type & 0x3) | ((direction & 0x3) << 2)) << shift(position));
+        }
+
+        /**
+         * @brief Set a range of positions to a type
+         *
+         * @details The positions in whole words are written a word at a time
+         *
+         * @param start first position
+         * @param count amount of positions
+         * @param type
+         */
+        void fill(size_t start, size_t count, const uint8_t type) {
+            // set the positions until the start of a word
+            for (; count && (start % per_word); start++, count--) {
+                set(start, type);
+            }
+
+            // set all the whole words
+            for (; count >= per_word; start += per_word, count -= per_word) {
+                words[start / per_word] = repeat(type);
+            }
+
+            // set the positions after the last whole word
+            for (; count; start++, count--) {
+                set(start, type);
+            }
+        }
+
+        /**
+         * @brief Set all the positions to a type
+         *
+         * @param type
+         */
+        void fill(const uint8_t type) {
+            for (auto &word : words) {
+                word = repeat(type);
+            }
+        }
+};
+
+#endif
@@ -0,0 +1,104 @@
+#include "perf_hud.hpp"
+
+const uint16_t perf_hud::glyphs[space + 1] = {
+    0b111'101'101'101'111, // 0
+    0b010'110'010'010'111, // 1
+    0b111'001'111'100'111, // 2
+    0b111'001'111'001'111, // 3
+    0b101'101'111'001'001, // 4
+    0b111'100'111'001'111, // 5
+    0b111'100'111'101'111, // 6
+    0b111'001'001'001'001, // 7
+    0b111'101'111'101'111, // 8
+    0b111'101'111'001'111, // 9
+    0b111'100'110'100'100, // F = fps
+    0b111'010'010'010'010, // T = frame time in us
+    0b110'101'110'101'110, // B = spi bytes
+    0b000'000'000'000'000  // space
+};
+
+perf_hud::perf_hud(hwlib_ssd1351 & window, const hwlib::location origin,
+                   spi_bus_counter * counter):
+    window(window), counter(counter), origin(origin),
+    foreground(window.foreground), background(window.background)
+{
+    redraw();
+}
+
+void perf_hud::draw_glyph(const uint8_t position, const uint8_t glyph) {
+    // the pixels of the character high byte first
+    uint8_t data[glyph_width * glyph_height * 2];
+
+    const uint16_t bits = glyphs[glyph];
+
+    for (uint8_t i = 0; i < glyph_width * glyph_height; i++) {
+        // the first pixel is in the highest bit
+        const rgb565 color = (bits & (1 << (glyph_width * glyph_height - 1 - i))) ?
+                             foreground : background;
+
+        data[i * 2] = color.high();
+        data[i * 2 + 1] = color.low();
+    }
+
+    // write the whole character in one burst
+    window.write_rect(
+        hwlib::location(origin.x + position * advance, origin.y),
+        hwlib::location(glyph_width, glyph_height), data
+    );
+}
+
+void perf_hud::draw_number(const uint8_t field, uint32_t value) {
+    // position of the last digit of the field. Every field has a label, the
+    // digits and a space
+    const uint8_t last = field * (1 + digits + 1) + digits;
+
+    // show the highest value when the value does not fit
+    if (value > 99'999) {
+        value = 99'999;
+    }
+
+    // write the digits from the right. The zeros before the value are empty
+    for (uint8_t i = 0; i < digits; i++) {
+        const uint8_t glyph = (value || !i) ? uint8_t(value % 10) : space;
+
+        value /= 10;
+
+        // skip the characters that are already on the screen
+        if (shown[field][digits - 1 - i] == glyph) {
+            continue;
+        }
+
+        shown[field][digits - 1 - i] = glyph;
+
+        draw_glyph(last - i, glyph);
+    }
+}
+
+void perf_hud::redraw() {
+    // clear the area of the hud
+    window.fill_rect(origin, hwlib::location(width, height), background);
+
+    for (uint8_t i = 0; i < fields; i++) {
+        // write the label in front of every value
+        draw_glyph(i * (1 + digits + 1), label + i);
+
+        // every digit needs to be written on the next update
+        for (auto &glyph : shown[i]) {
+            glyph = unknown;
+        }
+    }
+}
+
+void perf_hud::update(const uint32_t fps, const uint32_t frame_us) {
+    draw_number(0, fps);
+    draw_number(1, frame_us);
+
+    if (!counter) {
+        return;
+    }
+
+    // show the bytes since the last update. This includes the hud itself
+    draw_number(2, counter->bytes);
+
+    counter->reset();
+}
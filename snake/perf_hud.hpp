@@ -0,0 +1,112 @@
+#ifndef PERF_HUD_HPP
+#define PERF_HUD_HPP
+
+#include <hwlib.hpp>
+
+#include "hwlib_ssd1351.hpp"
+#include "spi_bus_counter.hpp"
+
+/**
+ * @brief Line with the fps, the frame time and the spi bytes of a frame
+ *
+ * @details Uses a 3x5 pixel font with only the digits and the labels. Every
+ * character is written with a single burst and only the characters that
+ * changed since the last update are written, so the overlay adds almost
+ * nothing to the frame it measures. Needs its own area of the screen that
+ * nothing else draws on.
+ *
+ */
+class perf_hud {
+    public:
+        // height of the area the hud needs
+        constexpr static uint8_t height = 5;
+
+        // width of the area the hud needs
+        constexpr static uint8_t width = 3 * (1 + 5 + 1) * 4;
+
+    protected:
+        // size of a character without the space after it
+        constexpr static uint8_t glyph_width = 3;
+        constexpr static uint8_t glyph_height = 5;
+
+        // distance between the start of two characters
+        constexpr static uint8_t advance = glyph_width + 1;
+
+        // amount of values and the digits of every value
+        constexpr static uint8_t fields = 3;
+        constexpr static uint8_t digits = 5;
+
+        // index of the first label and the empty character in the font
+        constexpr static uint8_t label = 10;
+        constexpr static uint8_t space = 13;
+
+        // the character that is not on the screen yet
+        constexpr static uint8_t unknown = 0xFF;
+
+        // the characters of the font. Every row is 3 bits with the top row in
+        // bits 12-14 and the left pixel in the highest bit of a row
+        static const uint16_t glyphs[space + 1];
+
+        // window to draw on
+        hwlib_ssd1351 & window;
+
+        // counter of the display bus. nullptr to skip the bytes
+        spi_bus_counter * counter;
+
+        // top left of the hud
+        hwlib::location origin;
+
+        // colors of the hud in the screen format
+        rgb565 foreground;
+        rgb565 background;
+
+        // the characters that are on the screen
+        uint8_t shown[fields][digits];
+
+        /**
+         * @brief Write a character in a single burst
+         *
+         * @param position index of the character on the line
+         * @param glyph index of the character in the font
+         */
+        void draw_glyph(const uint8_t position, const uint8_t glyph);
+
+        /**
+         * @brief Write the digits of a value that changed
+         *
+         * @param field index of the value
+         * @param value shown as the highest value that fits when too large
+         */
+        void draw_number(const uint8_t field, uint32_t value);
+
+    public:
+        /**
+         * @brief Construct a new performance hud
+         *
+         * @param window the window to draw on
+         * @param origin top left of the area of the hud
+         * @param counter counter of the display bus. nullptr to skip the bytes
+         */
+        perf_hud(hwlib_ssd1351 & window, const hwlib::location origin,
+                 spi_bus_counter * counter = nullptr);
+
+        /**
+         * @brief Draw the whole hud again
+         *
+         * @details Needed after the window is cleared
+         *
+         */
+        void redraw();
+
+        /**
+         * @brief Show the values of the last frame
+         *
+         * @details Reads and resets the bytes of the counter.
+         *
+         * @param fps
+         * @param frame_us time of the last frame in us
+         */
+        void update(const uint32_t fps, const uint32_t frame_us);
+};
+
+#endif
@@ -3,59 +3,101 @@
 
 #include <hwlib.hpp>
 #include <stdio.h>
-#include <stdlib.h>  
 
-#include "hwlib-font-color-16x16.hpp"
+#include "glyph_cache.hpp"
+#include "hwlib_ssd1351.hpp"
+#include "due_buttons.hpp"
+#include "frame_scheduler.hpp"
+#include "snake_logic.hpp"
+#include "draw_queue.hpp"
+#include "profiler.hpp"
+#include "perf_hud.hpp"
 
 namespace game {
 /**
- * @brief Snake game
+ * @brief Write the start screen of the game to a window
  * 
+ * @param window 
  */
-class snake {
-    private:   
-        /**
-         * @brief XY struct for positioning
-         * 
-         */
-        struct node{
-            // x coordinate
-            uint32_t x;
-            
-            // y coordinate
-            uint32_t y;
-        };  
+void write_start_screen(hwlib_ssd1351 &window);
 
+/**
+ * @brief Count the amount of decimal digits in a number
+ * 
+ * @param digit 
+ * @return uint8_t 
+ */
+uint8_t countdigits(uint32_t digit);
+
+/**
+ * @brief Snake game on a hwlib window
+ * 
+ * @details Reads the buttons, keeps the timing and draws the changes of the 
+ * game logic on the window. The size of the board and the size of a position
+ * on the screen are known at compile time.
+ * 
+ * @tparam W width of the game in positions including the walls
+ * @tparam H height of the game in positions including the walls
+ * @tparam ScreenW width of the screen in pixels
+ * @tparam ScreenH height of the screen in pixels
+ */
+template <uint8_t W, uint8_t H, uint8_t ScreenW, uint8_t ScreenH>
+class snake {
+    protected:   
         // height of the game
-        constexpr static uint8_t height = 32;
+        constexpr static uint8_t height = H;
         
         // width of the game
-        constexpr static uint8_t width = 32;
-    
-        // map for all the positions of the game
-        uint16_t map[height * width] = {};
+        constexpr static uint8_t width = W;
+
+        // size of a position on the screen in pixels
+        constexpr static uint8_t cell_width = ScreenW / W;
+        constexpr static uint8_t cell_height = ScreenH / H;
+
+        static_assert(ScreenW <= hwlib_ssd1351::width && ScreenH <= hwlib_ssd1351::height, 
+                      "the screen is larger than the panel");
+
+        static_assert(cell_width > 0 && cell_height > 0, 
+                      "the board does not fit the screen");
+
+        // rules and state of the game
+        snake_logic<W, H> logic;
 
         // window to show the game on
-        hwlib::window & window;
+        hwlib_ssd1351 & window;
+
+        // background of the window in the screen format
+        rgb565 background;
 
         // game buttons
-        hwlib::port_in_from_pins & buttons;
+        due_buttons & buttons;
 
-        // position of the head
-        node head = {width / 2, height / 2};
+        // maximum amount of different positions that are drawn in one burst
+        constexpr static size_t queue_size = 16;
 
-        // length of the snake (start lenght is 3)
-        uint16_t length = 3;
+        // changed positions that are not drawn yet
+        draw_queue<W, queue_size> queue;
 
-        // score of the game
-        uint16_t score = 0;        
+        // maximum amount of buffered turns that are used in a single step
+        constexpr static uint8_t turns_per_step = 1;
 
-        // direction
-        uint8_t direction:2;
-        uint8_t last_direction:2;
+        // seed of the random generator. 0 to use the time the game starts
+        uint32_t game_seed = 0;
 
         // target fps of the game
-        const uint8_t target_fps = 5;
+        constexpr static uint8_t target_fps = 5;
+
+        // starts the steps of the game on the target fps
+        frame_scheduler scheduler;
+
+        // amount of converted characters that are kept for the text
+        constexpr static size_t glyph_count = 8;
+
+        // the characters of the text in the screen format
+        glyph_cache<glyph_count> glyphs;
+
+        // overlay with the timing of the frames. nullptr when not shown
+        perf_hud * hud = nullptr;
 
         /**
          * @brief Setup the game for playing
@@ -64,42 +106,43 @@ class snake {
         void setup_game();
 
         /**
-         * @brief Get the current run time in ms
+         * @brief Wait until a button is pressed and all the buttons are released
          * 
-         * @return uint_fast64_t 
          */
-        uint_fast64_t now_ms();
+        void wait_for_button();
 
         /**
-         * @brief Try to move the snake in a direction and return if we hit something
+         * @brief Apply the buffered button presses to the game
+         * 
+         * @details Uses at most turns_per_step presses. The other presses stay 
+         * buffered for the next step so a fast second press is not lost.
          * 
-         * @param direction 
-         * @return uint8_t 
-         * 0 = no hit
-         * 1 = got food
-         * 2 = hit wall/ourselfs
          */
-        uint8_t move_direction(const uint8_t direction);
+        void apply_turns();
 
         /**
-         * @brief Move the snake to a relative position of the current position and return 
-         * if we hit something.
+         * @brief Queue the changes of a step of the game
+         * 
+         * @details The changes are drawn on the next render. When the queue 
+         * is full the queued changes are drawn first.
          * 
-         * @param x 
-         * @param y 
-         * @return uint8_t 
-         * 0 = no hit
-         * 1 = got food
-         * 2 = hit wall/ourselfs
+         * @param events 
          */
-        uint8_t move(const int8_t x, const int8_t y);
+        void draw(const step_events &events);
 
         /**
-         * @brief Change the direction usint the button input
+         * @brief Draw all the queued changes on the window
          * 
-         * @param buttons 
          */
-        void change_direction(const uint8_t buttons);        
+        void render();
+
+        /**
+         * @brief Get the color of a position on the screen
+         * 
+         * @param value 
+         * @return rgb565 
+         */
+        rgb565 color(const cell value) const;
 
         /**
          * @brief Write a whole screen block to the window
@@ -107,25 +150,38 @@ class snake {
          * @param block 
          * @param c 
          */
-        void write_screen_block(const uint16_t block, const hwlib::color color);
+        void write_screen_block(const uint16_t block, const rgb565 color);
+
+        /**
+         * @brief Write a rectangle of whole screen blocks to the window in one burst
+         * 
+         * @param block the top left block
+         * @param w amount of blocks in the x direction
+         * @param h amount of blocks in the y direction
+         * @param color 
+         */
+        void write_screen_blocks(const uint16_t block, const uint8_t w, const uint8_t h, 
+                                 const rgb565 color);
 
         /**
-         * @brief Spawn food on the game map and on the screen
+         * @brief Print the timing of the frames of the last game
          * 
          */
-        void spawn_food();        
+        void print_stats();
 
         /**
-         * @brief Update the snake by making it smaller and updating the screen
+         * @brief Write the result and the score of the game to the window
          * 
+         * @param won if the snake filled the whole board
          */
-        void screen_snake_update();
+        void write_score(const bool won);
 
         /**
          * @brief Show the death screen of the game
          * 
+         * @param won if the snake filled the whole board
          */
-        void death_screen();
+        void death_screen(const bool won);
 
         /**
          * @brief Show the start screen of the game
@@ -140,17 +196,370 @@ class snake {
          * @param display the window the game is running on
          * @param buttons two buttons that control the snake
          */
-        snake(hwlib::window & display, hwlib::port_in_from_pins & buttons):
-            window(display), buttons(buttons),
-            direction(0), last_direction(0)
+        snake(hwlib_ssd1351 & display, due_buttons & buttons):
+            window(display), buttons(buttons), scheduler(1'000'000 / target_fps)
         {}
 
+        /**
+         * @brief Show the timing of every frame on a hud
+         * 
+         * @details The hud needs an area of the window outside of the game. 
+         * Needs to be called before run.
+         * 
+         * @param hud 
+         */
+        void show_hud(perf_hud & hud) {
+            this->hud = &hud;
+        }
+
+        /**
+         * @brief Set the seed of the random generator
+         * 
+         * @details The same seed gives the same food positions when the snake 
+         * makes the same moves. Needs to be called before run.
+         * 
+         * @param seed the seed to use. 0 to use the time the game starts
+         */
+        void seed(const uint32_t seed) {
+            game_seed = seed;
+        }
+
+        /**
+         * @brief Get the seed of the random generator
+         * 
+         * @details Returns the seed that is used after the game is started
+         * 
+         * @return uint32_t 
+         */
+        uint32_t get_seed() const {
+            return game_seed;
+        }
+
         /**
          * @brief Run the game in an endless loop until the snake dies
          * 
          */
     	void run();
 };
+
+template <uint8_t W, uint8_t H, uint8_t ScreenW, uint8_t ScreenH>
+void snake<W, H, ScreenW, ScreenH>::setup_game() {
+    // use the start time when no seed is set
+    if (!game_seed) {
+        game_seed = uint32_t(hwlib::now_ticks());
+    }
+
+    // print the seed so the game can be replayed. Passing the printed value
+    // to seed gives the same seed
+    hwlib::cout << "seed: " << int(game_seed) << "\n";
+
+    // convert the background of the window once
+    background = window.background;
+
+    // start the game and show the head and the food
+    draw(logic.reset(game_seed));
+
+    // show a grey color on the top and bottom wall
+    write_screen_blocks(0, width, 1, color565::gray);
+    write_screen_blocks(width * (height - 1), width, 1, color565::gray);
+
+    // show a grey color on the left and right wall
+    write_screen_blocks(width, 1, height - 2, color565::gray);
+    write_screen_blocks(width + (width - 1), 1, height - 2, color565::gray);
+
+    // draw the head and the food
+    render();
+
+    // draw the hud again after the clear
+    if (hud) {
+        hud->redraw();
+    }
+}
+
+template <uint8_t W, uint8_t H, uint8_t ScreenW, uint8_t ScreenH>
+void snake<W, H, ScreenW, ScreenH>::wait_for_button() {
+    // ignore the presses before we started waiting
+    buttons.clear();
+
+    // sleep until a button is pressed. The button interrupt wakes us up
+    buttons.sleep_until([this]() {
+        button_event event;
+
+        // read every change so a press behind a release is not missed
+        while (buttons.pop(event)) {
+            if (event.pressed) {
+                return true;
+            }
+        }
+
+        return false;
+    });
+
+    // sleep until the buttons are released
+    buttons.sleep_until([this]() {
+        return buttons.get() == 0;
+    });
+
+    // ignore the release events
+    buttons.clear();
+}
+
+template <uint8_t W, uint8_t H, uint8_t ScreenW, uint8_t ScreenH>
+void snake<W, H, ScreenW, ScreenH>::apply_turns() {
+    PROFILE_ZONE(input);
+
+    uint8_t turns = 0;
+
+    button_event event;
+
+    // use the presses in the order they happened
+    while (turns < turns_per_step && buttons.pop(event)) {
+
+        // releases do not turn the snake. Pressing both buttons at once 
+        // does not turn either. Use the state at the time of the press
+        if (!event.pressed || event.state == 0x03) {
+            continue;
+        }
+
+        // update the direction using the button input
+        logic.press(event.button);
+
+        turns++;
+    }
+}
+
+template <uint8_t W, uint8_t H, uint8_t ScreenW, uint8_t ScreenH>
+void snake<W, H, ScreenW, ScreenH>::draw(const step_events &events) {
+    // queue every changed position in the order it changed
+    for (uint8_t i = 0; i < events.count; i++) {
+        if (!queue.add(events.changes[i])) {
+            // make room by drawing what we have
+            render();
+            queue.add(events.changes[i]);
+        }
+    }
+}
+
+template <uint8_t W, uint8_t H, uint8_t ScreenW, uint8_t ScreenH>
+void snake<W, H, ScreenW, ScreenH>::render() {
+    PROFILE_ZONE(render);
+
+    // draw every run of positions with the same color in one burst
+    queue.flush([this](const uint16_t position, const uint8_t length, const cell value) {
+        write_screen_blocks(position, length, 1, color(value));
+    });
+}
+
+template <uint8_t W, uint8_t H, uint8_t ScreenW, uint8_t ScreenH>
+rgb565 snake<W, H, ScreenW, ScreenH>::color(const cell value) const {
+    switch (value) {
+        case cell::wall:
+            return color565::gray;
+        case cell::food:
+            return color565::red;
+        case cell::snake:
+            return color565::green;
+        default:
+            return background;
+    }
+}
+
+template <uint8_t W, uint8_t H, uint8_t ScreenW, uint8_t ScreenH>
+void snake<W, H, ScreenW, ScreenH>::write_screen_block(const uint16_t block, const rgb565 color) {
+    // write a single block to the screen
+    write_screen_blocks(block, 1, 1, color);
+}
+
+template <uint8_t W, uint8_t H, uint8_t ScreenW, uint8_t ScreenH>
+void snake<W, H, ScreenW, ScreenH>::write_screen_blocks(const uint16_t block, const uint8_t w, const uint8_t h, 
+                                                        const rgb565 color) {
+    // get the row and column of the block. The width is known at compile 
+    // time so this does not need a division instruction
+    const uint16_t row = block / width;
+    const uint8_t column = block % width;
+
+    // write the scaled blocks of color to the screen in one burst
+    window.fill_rect(
+        hwlib::location(column * cell_width, row * cell_height), 
+        hwlib::location(w * cell_width, h * cell_height), color
+    );
+}
+
+template <uint8_t W, uint8_t H, uint8_t ScreenW, uint8_t ScreenH>
+void snake<W, H, ScreenW, ScreenH>::run() {
+    //load start screen
+    start_screen(); 
+
+    // flush the window to show the start screen
+    window.flush();
+
+    // wait on any keypress
+    wait_for_button();
+
+    // clear the screen
+    window.clear();
+
+    // init the game
+    setup_game();
+
+    // flush the window to update the screen
+    window.flush();
+
+    // start the deadlines of the steps from now
+    scheduler.start();
+
+    // clear the measurements of the last game
+    PROFILE_RESET();
+
+    // loop until the snake dies
+    while (true) {
+        // sleep until the next step. Button presses are queued while sleeping
+        scheduler.wait();
+
+        // update the direction using the buffered button presses
+        apply_turns();
+
+        step_events events;
+
+        {
+            PROFILE_ZONE(logic);
+
+            // move the snake to the next position
+            events = logic.step();
+
+            // queue the changes of the snake
+            draw(events);
+        }
+
+        scheduler.logic_done();
+
+        // update the snake on the screen
+        render();
+
+        // check if we hit something we should not or filled the board
+        if (events.result == step_result::died || events.result == step_result::won) {
+            // show the timing of the game
+            print_stats();
+
+            // show the death screen
+            death_screen(events.result == step_result::won);
+
+            // clear the window
+            window.clear();
+
+            // flush the clear to the window
+            window.flush();
+
+            // break the loop to exit the function
+            break;
+        }
+
+        // show the timing of the last frame
+        if (hud) {
+            const uint32_t interval = frame_scheduler::to_us(scheduler.get_interval());
+
+            hud->update(interval ? 1'000'000 / interval : 0, 
+                        frame_scheduler::to_us(scheduler.get_frame_time()));
+        }
+
+        {
+            PROFILE_ZONE(flush);
+
+            // flush the screen
+            window.flush();
+        }
+
+        scheduler.render_done();
+    }
+}
+
+template <uint8_t W, uint8_t H, uint8_t ScreenW, uint8_t ScreenH>
+void snake<W, H, ScreenW, ScreenH>::start_screen() {
+    // write the converted image to the display in one burst
+    write_start_screen(window);
+}
+
+template <uint8_t W, uint8_t H, uint8_t ScreenW, uint8_t ScreenH>
+void snake<W, H, ScreenW, ScreenH>::print_stats() {
+    const frame_stats &stats = scheduler.get_stats();
+
+    // prevent a division by zero when the snake died in the first frame
+    const uint32_t frames = stats.frames ? stats.frames : 1;
+
+    // print all the times in us
+    hwlib::cout << "frames: " << int(stats.frames) 
+                << " overruns: " << int(stats.overruns) << "\n";
+
+    hwlib::cout << "jitter avg: " << int(frame_scheduler::to_us(stats.jitter_total / frames)) 
+                << " max: " << int(frame_scheduler::to_us(stats.jitter_max)) << "\n";
+
+    hwlib::cout << "logic avg: " << int(frame_scheduler::to_us(stats.logic_total / frames)) 
+                << " max: " << int(frame_scheduler::to_us(stats.logic_max)) << "\n";
+
+    hwlib::cout << "render avg: " << int(frame_scheduler::to_us(stats.render_total / frames)) 
+                << " max: " << int(frame_scheduler::to_us(stats.render_max)) << "\n";
+
+    // print the cycles of the profiling zones
+    PROFILE_DUMP();
+}
+
+template <uint8_t W, uint8_t H, uint8_t ScreenW, uint8_t ScreenH>
+void snake<W, H, ScreenW, ScreenH>::write_score(const bool won) {
+    // create a ostream object of the window that writes every character 
+    // in a single burst
+    glyph_ostream<glyph_count> t_display(window, glyphs, window.foreground, window.background);
+
+    // print text on the display
+    t_display << "\t0001" << (won ? "You won" : "You died") << "\t0103" << "Score:" << "\t0204" ;
+    
+    // add enough zero's to fill 4 characters including the score
+    for (int i = 0; i < 4 - countdigits(logic.get_score()); i++) {
+        // print zero's to the screen
+        t_display << "0";
+    }
+    
+    // print the score and flush the display
+    t_display << logic.get_score() << hwlib::flush;
+}
+
+template <uint8_t W, uint8_t H, uint8_t ScreenW, uint8_t ScreenH>
+void snake<W, H, ScreenW, ScreenH>::death_screen(const bool won) {
+    // loop until the whole snake is removed
+    while (logic.get_size()) {
+        // make the snake 1 smaller
+        draw(logic.shrink());
+
+        // draw the removed position
+        render();
+
+        // flush the window
+        window.flush();
+
+        // wait 1 frame time
+        hwlib::wait_ms(500);
+    }
+
+    // wait 250 ms
+    hwlib::wait_ms(250);
+
+    // clear the screen
+    window.clear();
+
+    // wait 250 ms
+    hwlib::wait_ms(250);
+
+    // flush the clear to the window
+    window.flush();
+
+    // show the result and the score
+    write_score(won);
+
+    // wait on any keypress
+    wait_for_button();
+}
+
+// the default game is compiled once in snake.cpp
+extern template class snake<32, 32, 128, 128>;
 }
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,6 @@
+#include "snake_logic.hpp"
+
+namespace game {
+// compile the default game once for all the users
+template class snake_logic<32, 32>;
+}
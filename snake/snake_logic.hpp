@@ -0,0 +1,559 @@
+#ifndef SNAKE_LOGIC_HPP
+#define SNAKE_LOGIC_HPP
+
+#include <stdint.h>
+
+#include "packed_board.hpp"
+#include "index_set.hpp"
+#include "xorshift.hpp"
+#include "profiler.hpp"
+
+namespace game {
+/**
+ * @brief Contents of a position on the map
+ *
+ */
+enum class cell : uint8_t {
+    empty = 0,
+    wall = 1,
+    food = 2,
+    snake = 3
+};
+
+/**
+ * @brief Result of a step of the game
+ *
+ */
+enum class step_result : uint8_t {
+    // the snake moved to a empty position
+    moved = 0,
+
+    // the snake ate food
+    food = 1,
+
+    // the snake hit a wall or itself
+    died = 2,
+
+    // the snake filled the whole board
+    won = 3
+};
+
+/**
+ * @brief A position on the map that changed
+ *
+ */
+struct cell_change {
+    // position on the map
+    uint16_t position;
+
+    // new contents of the position
+    cell value;
+};
+
+/**
+ * @brief Everything that changed in a step of the game
+ *
+ */
+struct step_events {
+    // maximum amount of changed positions in a step (head, tail and food)
+    constexpr static uint8_t max_changes = 4;
+
+    // result of the step
+    step_result result;
+
+    // the positions that changed in the order they changed
+    cell_change changes[max_changes];
+
+    // amount of changed positions
+    uint8_t count;
+
+    /**
+     * @brief Add a changed position
+     *
+     * @param position
+     * @param value
+     */
+    void add(const uint16_t position, const cell value) {
+        if (count < max_changes) {
+            changes[count++] = {position, value};
+        }
+    }
+};
+
+/**
+ * @brief Rules of the snake game without any input or output
+ *
+ * @details Every step moves the snake one position and returns what changed
+ * on the map so a adapter can draw it. Does not use hwlib so the game can be
+ * run on a host.
+ *
+ * The ram is mostly used by the set of empty positions, which takes 4 bytes
+ * for every position between the walls. The map only takes half a byte per
+ * position. A 32x32 game uses about 3.6 kb for the set and 512 bytes for the
+ * map.
+ *
+ * @tparam W width of the game including the walls
+ * @tparam H height of the game including the walls
+ */
+template <uint8_t W, uint8_t H>
+class snake_logic {
+    public:
+        // height of the game
+        constexpr static uint8_t height = H;
+
+        // width of the game
+        constexpr static uint8_t width = W;
+
+        // the walls need room for at least one position between them
+        static_assert(W >= 3 && H >= 3, "the game needs at least 3x3 positions");
+
+        // the game needs to fit in the sram next to the 32 kb framebuffer.
+        // 64x64 positions take about 17 kb
+        static_assert(W * H <= 64 * 64, "the game does not fit in the sram");
+
+    protected:
+        /**
+         * @brief XY struct for positioning
+         *
+         */
+        struct node{
+            // x coordinate
+            uint32_t x;
+
+            // y coordinate
+            uint32_t y;
+        };
+
+        // map for all the positions of the game. Every position of the snake
+        // stores the direction to the next position towards the head
+        packed_board<height * width> map;
+
+        // position of the last part of the snake
+        uint16_t tail = 0;
+
+        // amount of positions the snake is on
+        uint16_t size = 0;
+
+        // amount of positions between the walls
+        constexpr static uint16_t inside_size = (width - 2) * (height - 2);
+
+        // positions between the walls that are empty. Used to spawn food
+        // without searching for a empty position. Stores the index between
+        // the walls (see inside_index) to keep the set small
+        index_set<inside_size> free_cells;
+
+        // random generator for the food positions
+        xorshift32 random;
+
+        // position of the head
+        node head = {width / 2, height / 2};
+
+        // length of the snake (start lenght is 3)
+        uint16_t length = 3;
+
+        // score of the game
+        uint16_t score = 0;
+
+        // direction
+        uint8_t direction:2;
+        uint8_t last_direction:2;
+
+        /**
+         * @brief Get the difference in position of a step in a direction
+         *
+         * @param direction
+         * @return int16_t
+         */
+        constexpr static int16_t offset(const uint8_t direction) {
+            return direction == 0 ? -1 : (direction == 1 ? width : (direction == 2 ? 1 : -width));
+        }
+
+        /**
+         * @brief Get the position of the head on the map
+         *
+         * @return uint16_t
+         */
+        uint16_t head_position() const {
+            return uint16_t(head.x + head.y * width);
+        }
+
+        /**
+         * @brief Get the index of a position between the walls
+         *
+         * @param position position on the map
+         * @return uint16_t inside_size for a position on a wall
+         */
+        constexpr static uint16_t inside_index(const uint16_t position) {
+            const uint16_t x = position % width;
+            const uint16_t y = position / width;
+
+            if (x == 0 || y == 0 || x >= (width - 1) || y >= (height - 1)) {
+                return inside_size;
+            }
+
+            return uint16_t((x - 1) + (y - 1) * (width - 2));
+        }
+
+        /**
+         * @brief Get the position on the map of a index between the walls
+         *
+         * @param index
+         * @return uint16_t
+         */
+        constexpr static uint16_t map_position(const uint16_t index) {
+            return uint16_t((index % (width - 2)) + 1 + ((index / (width - 2)) + 1) * width);
+        }
+
+        /**
+         * @brief Change a position on the map and keep track of the empty positions
+         *
+         * @param position
+         * @param value
+         * @param direction direction to the next position of the snake
+         */
+        void set_cell(const uint16_t position, const cell value, const uint8_t direction = 0);
+
+        /**
+         * @brief Try to move the snake in a direction and return if we hit something
+         *
+         * @param direction
+         * @param events
+         * @return cell what was on the new position
+         */
+        cell move_direction(const uint8_t direction, step_events &events);
+
+        /**
+         * @brief Move the snake to a relative position of the current position and return
+         * if we hit something.
+         *
+         * @param x
+         * @param y
+         * @param events
+         * @return cell what was on the new position
+         */
+        cell move(const int8_t x, const int8_t y, step_events &events);
+
+        /**
+         * @brief Spawn food on a random empty position
+         *
+         * @param events
+         * @return true when the food is placed
+         * @return false when the board is full
+         */
+        bool spawn_food(step_events &events);
+
+        /**
+         * @brief Remove the tail of the snake from the map
+         *
+         * @param events
+         */
+        void remove_tail(step_events &events);
+
+    public:
+        snake_logic():
+            direction(0), last_direction(0)
+        {}
+
+        /**
+         * @brief Start a new game
+         *
+         * @details The walls are not part of the events. They are always on the
+         * edges of the map.
+         *
+         * @param seed seed of the random generator for the food
+         * @return step_events the head and the first food
+         */
+        step_events reset(const uint32_t seed);
+
+        /**
+         * @brief Change the direction using the button input
+         *
+         * @details Only one turn relative to the direction of the last step is
+         * allowed.
+         *
+         * @param buttons bit 0 = turn one way, bit 1 = turn the other way
+         */
+        void press(const uint8_t buttons);
+
+        /**
+         * @brief Move the snake one position
+         *
+         * @param buttons buttons that are pressed for this step. 0 to keep the
+         * direction
+         * @return step_events
+         */
+        step_events step(const uint8_t buttons = 0);
+
+        /**
+         * @brief Make the snake one position smaller
+         *
+         * @details Used to remove the snake after the game
+         *
+         * @return step_events the removed position. No changes when the snake
+         * is already removed
+         */
+        step_events shrink();
+
+        /**
+         * @brief Get what is on a position of the map
+         *
+         * @param position
+         * @return cell
+         */
+        cell get_cell(const uint16_t position) const {
+            return cell(map.type(position));
+        }
+
+        /**
+         * @brief Get the score of the game
+         *
+         * @return uint16_t
+         */
+        uint16_t get_score() const {
+            return score;
+        }
+
+        /**
+         * @brief Get the amount of positions the snake is on
+         *
+         * @return uint16_t
+         */
+        uint16_t get_size() const {
+            return size;
+        }
+
+        /**
+         * @brief Get the length of the snake
+         *
+         * @return uint16_t
+         */
+        uint16_t get_length() const {
+            return length;
+        }
+};
+
+template <uint8_t W, uint8_t H>
+step_events snake_logic<W, H>::reset(const uint32_t seed) {
+    step_events events = {};
+
+    // init the random generator
+    random.seed(seed);
+
+    head = {width / 2, height / 2};
+    length = 3;
+    score = 0;
+    direction = 0;
+    last_direction = 0;
+
+    // start from a empty map
+    map.fill(uint8_t(cell::empty));
+
+    // set the top and bottom edge to wall in the map a word at a time
+    map.fill(0, width, uint8_t(cell::wall));
+    map.fill(width * (height - 1), width, uint8_t(cell::wall));
+
+    for (uint8_t i = 1; i < (height - 1); i++) {
+        // set the left edge to wall in the map
+        map.set(i * width, uint8_t(cell::wall));
+
+        // set the right edge to wall in the map
+        map.set((width -1) + i * width, uint8_t(cell::wall));
+    }
+
+    // every position between the walls is empty
+    free_cells.clear();
+
+    for (uint16_t i = 0; i < inside_size; i++) {
+        free_cells.insert(i);
+    }
+
+    // set the start position in the map
+    set_cell(head_position(), cell::snake);
+
+    // the head is the only part of the snake at the start
+    tail = head_position();
+    size = 1;
+
+    events.add(head_position(), cell::snake);
+
+    // spawn food in the game
+    spawn_food(events);
+
+    return events;
+}
+
+template <uint8_t W, uint8_t H>
+void snake_logic<W, H>::press(const uint8_t buttons) {
+    // check if button 1 is pressed
+    if (buttons & 0x1) {
+        if (direction <= last_direction) {
+            direction++;
+        }
+    }
+    // check if button 2 is pressed
+    if (buttons & 0x2) {
+        if (direction >= last_direction) {
+            direction--;
+        }
+    }
+}
+
+template <uint8_t W, uint8_t H>
+step_events snake_logic<W, H>::step(const uint8_t buttons) {
+    step_events events = {};
+
+    // apply the buttons of this step
+    press(buttons);
+
+    last_direction = direction;
+
+    // link the current head to the position we move to
+    map.set(head_position(), uint8_t(cell::snake), direction);
+
+    // move the snake to the next position and get what we hit
+    const cell hit = move_direction(direction, events);
+
+    // a position stays part of the snake for length - 1 moves
+    while (size > length - 1u) {
+        remove_tail(events);
+    }
+
+    // check if we hit ourselfs or a wall
+    if (hit == cell::wall || hit == cell::snake) {
+        events.result = step_result::died;
+    }
+    // check if we got food
+    else if (hit == cell::food) {
+        // increment the score
+        score++;
+
+        // increment the length
+        length++;
+
+        // spawn new food. The game is won when there is no room left
+        events.result = spawn_food(events) ? step_result::food : step_result::won;
+    }
+    else {
+        events.result = step_result::moved;
+    }
+
+    return events;
+}
+
+template <uint8_t W, uint8_t H>
+step_events snake_logic<W, H>::shrink() {
+    step_events events = {};
+
+    // make the snake 1 smaller
+    if (size) {
+        remove_tail(events);
+    }
+
+    return events;
+}
+
+template <uint8_t W, uint8_t H>
+void snake_logic<W, H>::set_cell(const uint16_t position, const cell value, const uint8_t direction) {
+    map.set(position, uint8_t(value), direction);
+
+    const uint16_t index = inside_index(position);
+
+    // the walls are never empty. The head can be on one when it hits it
+    if (index == inside_size) {
+        return;
+    }
+
+    // keep the empty positions up to date
+    if (value == cell::empty) {
+        free_cells.insert(index);
+    }
+    else {
+        free_cells.erase(index);
+    }
+}
+
+template <uint8_t W, uint8_t H>
+cell snake_logic<W, H>::move_direction(const uint8_t direction, step_events &events) {
+    // move the snake and return what we hit
+    switch (direction) {
+        case 0:
+            return move(-1, 0, events);
+        case 1:
+            return move(0, 1, events);
+        case 2:
+            return move(1, 0, events);
+        default:
+            return move(0, -1, events);
+    }
+}
+
+template <uint8_t W, uint8_t H>
+cell snake_logic<W, H>::move(const int8_t x, const int8_t y, step_events &events) {
+    PROFILE_ZONE(move);
+
+    // calculate the new head position
+    head.x += x;
+    head.y += y;
+
+    // get the map data on the new location
+    const cell map_data = get_cell(head_position());
+
+    // update the position on the map. When we hit ourselfs the position 
+    // keeps the link to the next position so the snake can still be removed
+    if (map_data != cell::snake) {
+        set_cell(head_position(), cell::snake);
+    }
+
+    // add the new head to the snake
+    size++;
+
+    events.add(head_position(), cell::snake);
+
+    return map_data;
+}
+
+template <uint8_t W, uint8_t H>
+void snake_logic<W, H>::remove_tail(step_events &events) {
+    // remove the tail from the snake and follow the link to the next position
+    const uint16_t position = tail;
+
+    tail = uint16_t(position + offset(map.direction(position)));
+    size--;
+
+    // the head can move on the old tail when the snake hits itself. Keep
+    // the head on the map until the last position of the snake is removed
+    if (position == head_position() && size) {
+        return;
+    }
+
+    // remove the tail from the map
+    set_cell(position, cell::empty);
+
+    events.add(position, cell::empty);
+}
+
+template <uint8_t W, uint8_t H>
+bool snake_logic<W, H>::spawn_food(step_events &events) {
+    PROFILE_ZONE(spawn_food);
+
+    // check if there is any room left for food
+    if (free_cells.size() == 0) {
+        return false;
+    }
+
+    // get a random empty position for the food
+    const uint16_t position = map_position(free_cells[random.next(free_cells.size())]);
+
+    // set the map location to food
+    set_cell(position, cell::food);
+
+    events.add(position, cell::food);
+
+    return true;
+}
+
+// the default game is compiled once in snake_logic.cpp
+extern template class snake_logic<32, 32>;
+}
+
+#endif
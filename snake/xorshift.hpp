@@ -0,0 +1,81 @@
+#ifndef XORSHIFT_HPP
+#define XORSHIFT_HPP
+
+#include <stdint.h>
+
+/**
+ * @brief Small pseudo random number generator (xorshift32)
+ *
+ * @details The same seed always gives the same numbers. Only uses shifts and
+ * xors so it is a lot faster than the rand of the c library and has no
+ * global state.
+ *
+ */
+class xorshift32 {
+    protected:
+        // state of the generator. Never 0
+        uint32_t state;
+
+    public:
+        /**
+         * @brief Construct a new xorshift32 object
+         *
+         * @param seed
+         */
+        constexpr xorshift32(const uint32_t seed = 1):
+            state(seed ? seed : 1)
+        {}
+
+        /**
+         * @brief Restart the generator with a seed
+         *
+         * @details A seed of 0 is changed to 1 as the generator would only
+         * return 0
+         *
+         * @param seed
+         */
+        void seed(const uint32_t seed) {
+            state = seed ? seed : 1;
+        }
+
+        /**
+         * @brief Get the next random number
+         *
+         * @return uint32_t
+         */
+        uint32_t next() {
+            state ^= state << 13;
+            state ^= state >> 17;
+            state ^= state << 5;
+
+            return state;
+        }
+
+        /**
+         * @brief Get a random number in the range [0, range) without modulo bias
+         *
+         * @details Multiplies the random number with the range and uses the high
+         * part. The few numbers that would make some results more likely are
+         * thrown away.
+         *
+         * @param range amount of possible results. Should not be 0
+         * @return uint32_t
+         */
+        uint32_t next(const uint32_t range) {
+            uint64_t m = uint64_t(next()) * range;
+
+            // check if the low part is in the part that gives a bias
+            if (uint32_t(m) < range) {
+                // (2^32 - range) % range
+                const uint32_t threshold = (0u - range) % range;
+
+                while (uint32_t(m) < threshold) {
+                    m = uint64_t(next()) * range;
+                }
+            }
+
+            return uint32_t(m >> 32);
+        }
+};
+
+#endif
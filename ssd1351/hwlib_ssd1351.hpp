@@ -3,15 +3,177 @@
 
 #include <hwlib.hpp>
 #include "ssd1351.hpp"
+#include "rgb565.hpp"
 
+/**
+ * @brief hwlib window on a ssd1351 screen
+ * 
+ * @details The functions the game draws with. The screen driver is bound by
+ * hwlib_ssd1351_t, so the users of the window do not depend on the bus and 
+ * the pin types.
+ * 
+ */
 class hwlib_ssd1351: public hwlib::window {
     protected:
-        // display driver
-        ssd1351 display;
+        // last converted color. Most writes use the same color as the
+        // write before so the conversion can be skipped
+        hwlib::color last_color;
+        rgb565 last_data;
+
+        /**
+         * @brief Convert a color to the screen format
+         * 
+         * @details Only converts when the color is different from the last color
+         * 
+         * @param color 
+         * @return rgb565 
+         */
+        rgb565 color_to_data(const hwlib::color &color) {
+            // check if we need to convert the color
+            if (color.red != last_color.red || color.green != last_color.green || 
+                color.blue != last_color.blue) {
+                // convert the color and store it for the next time
+                last_color = color;
+                last_data = rgb565(color);
+            }
+
+            return last_data;
+        }
 
+        /**
+         * @brief Clip a rectangle to the screen
+         * 
+         * @param pos the top left location. Moved to the first pixel on the screen
+         * @param size the width and height. Shrunk to the part on the screen
+         * @return bool if a part of the rectangle is on the screen
+         */
+        static bool clip(hwlib::location &pos, hwlib::location &size) {
+            // remove the part left and above the screen
+            if (pos.x < 0) {
+                size.x += pos.x;
+                pos.x = 0;
+            }
+
+            if (pos.y < 0) {
+                size.y += pos.y;
+                pos.y = 0;
+            }
+
+            // remove the part right and below the screen
+            if (pos.x + size.x > width) {
+                size.x = width - pos.x;
+            }
+
+            if (pos.y + size.y > height) {
+                size.y = height - pos.y;
+            }
+
+            return size.x > 0 && size.y > 0;
+        }
+
+        /**
+         * @brief Write a single pixel that is already in the screen format
+         * 
+         * @param pos the location of the pixel
+         * @param col the color of the pixel
+         */
+        virtual void write_pixel(hwlib::location pos, rgb565 col) = 0;
+
+    public:
         // height and width of the screen
-        const uint8_t height = 128;
-        const uint8_t width = 128;
+        constexpr static uint8_t height = 128;
+        constexpr static uint8_t width = 128;
+
+        hwlib_ssd1351():
+            hwlib::window(hwlib::location(height, width), hwlib::black, hwlib::white),
+            last_color(hwlib::black), last_data(color565::black)
+        {}
+
+        /**
+         * @brief the write implementation for the oled screen
+         * 
+         * @param pos the location of the pixel
+         * @param col the color of the pixel
+         * @param buf un/buffered 
+         */
+        void write_implementation(hwlib::location pos, hwlib::color col, hwlib::buffering buf = hwlib::buffering::unbuffered) override {
+            // write the pixel in the screen format
+            write_pixel(pos, color_to_data(col));
+        }
+
+        // the hwlib color writes of the window
+        using hwlib::window::write;
+
+        /**
+         * @brief Write a pixel that is already in the screen format
+         * 
+         * @param pos the location of the pixel
+         * @param col the color of the pixel
+         */
+        void write(hwlib::location pos, rgb565 col) {
+            write_pixel(pos, col);
+        }
+
+        /**
+         * @brief Write a rectangle of pixel data to the screen in one burst
+         * 
+         * @details Only the part of the rectangle on the screen is written
+         * 
+         * @param pos the top left location of the rectangle
+         * @param size the width and height of the rectangle
+         * @param data pixel data (2 bytes per pixel, high byte first). Needs 
+         * size.x * size.y * 2 bytes
+         */
+        virtual void write_rect(hwlib::location pos, hwlib::location size, const uint8_t *data) = 0;
+
+        /**
+         * @brief Fill a rectangle on the screen with a single color
+         * 
+         * @param pos the top left location of the rectangle
+         * @param size the width and height of the rectangle
+         * @param col the color to fill the rectangle with
+         */
+        void fill_rect(hwlib::location pos, hwlib::location size, hwlib::color col) {
+            // fill the rectangle in the screen format
+            fill_rect(pos, size, color_to_data(col));
+        }
+
+        /**
+         * @brief Fill a rectangle on the screen with a color that is already in
+         * the screen format
+         * 
+         * @details Only the part of the rectangle on the screen is filled
+         * 
+         * @param pos the top left location of the rectangle
+         * @param size the width and height of the rectangle
+         * @param col the color to fill the rectangle with
+         */
+        virtual void fill_rect(hwlib::location pos, hwlib::location size, rgb565 col) = 0;
+
+        /**
+         * @brief clears the screen
+         * 
+         * @param buf 
+         */
+        void clear(hwlib::buffering buf = hwlib::buffering::unbuffered) override {
+            // fill the whole screen with the background in one burst
+            fill_rect(hwlib::location(0, 0), hwlib::location(width, height), window::background);
+        }
+};
+
+/**
+ * @brief hwlib window on a ssd1351 screen with the driver bound at compile time
+ * 
+ * @details Every call on the driver is a direct call. With a driver on hwspi
+ * and the due pins the data/command changes and the byte pushes are inlined.
+ * 
+ * @tparam Driver ssd1351_t with the bus and the pin types of the screen
+ */
+template <typename Driver>
+class hwlib_ssd1351_t: public hwlib_ssd1351 {
+    protected:
+        // display driver
+        Driver display;
 
         // last cursor position
     	uint8_t x;
@@ -40,20 +202,55 @@ class hwlib_ssd1351: public hwlib::window {
         }
 
         /**
-         * @brief Convert a color to a uint16_t
+         * @brief Write a single pixel that is already in the screen format
          * 
-         * @param color 
-         * @return uint16_t 
+         * @param pos the location of the pixel
+         * @param col the color of the pixel
          */
-        uint16_t color_to_data(const hwlib::color &color) {
-            return (((uint16_t(color.red) * 0x1F) / 0xFF) << 11) | 
-                   (((uint16_t(color.green) * 0x3F) / 0xFF) << 5) |
-                   ((uint16_t(color.blue) * 0x1F) / 0xFF);
+        void write_pixel(hwlib::location pos, rgb565 col) override {
+            // skip the pixels that are not on the screen
+            if (pos.x < 0 || pos.y < 0 || pos.x >= width || pos.y >= height) {
+                return;
+            }
+
+            // convert the color to a array
+            uint8_t buffer[2] = {col.high(), col.low()};
+
+            // update the screen cursor
+            set_cursor(pos.x, pos.y);
+
+            // write the screen data
+            display.write_screen_data(buffer, sizeof(buffer));
+
+            // update the cursor
+            if (x < (width - 1)) {
+                // increment the row to the next
+                x++;
+            }
+            else if (y < (height - 1)) {
+                // reset the x cursor position
+                x = 0;
+
+                // change cursor to the beginning 
+                display.set_column_address(0, width - 1);
+
+                // increment the column to the next
+                y++;
+            }
+            else {
+                // we reached the end of the screen reset the row and column
+                x = 0;
+                y = 0;
+
+                // set the cursor to the start
+                display.set_column_address(0, width - 1);
+                display.set_row_address(0, height - 1);
+            }
         }
 
     public:
-        hwlib_ssd1351(hwlib::spi_bus & spi, hwlib::pin_out & reset, hwlib::pin_out & dc, hwlib::pin_out & cs):
-            hwlib::window(hwlib::location(height, width), hwlib::black, hwlib::white),
+        hwlib_ssd1351_t(typename Driver::bus_type & spi, typename Driver::reset_type & reset, 
+                        typename Driver::dc_type & dc, typename Driver::cs_type & cs):
             display(spi, reset, dc, cs), x(0), y(0)
         { 
             // disable command lock
@@ -99,81 +296,81 @@ class hwlib_ssd1351: public hwlib::window {
         }
 
         /**
-         * @brief the write implementation for the oled screen
+         * @brief Write a rectangle of pixel data to the screen in one burst
          * 
-         * @param pos the location of the pixel
-         * @param col the color of the pixel
-         * @param buf un/buffered 
+         * @details Only the part of the rectangle on the screen is written
+         * 
+         * @param pos the top left location of the rectangle
+         * @param size the width and height of the rectangle
+         * @param data pixel data (2 bytes per pixel, high byte first). Needs 
+         * size.x * size.y * 2 bytes
          */
-        void write_implementation(hwlib::location pos, hwlib::color col, hwlib::buffering buf = hwlib::buffering::unbuffered) override {
-            // get binary data from a color
-            uint16_t color = color_to_data(col);
-
-            // convert the uint16_t to a array
-            uint8_t buffer[2] = {uint8_t(color >> 8), uint8_t(color & 0xFF)};
-
-            // update the screen cursor
-            set_cursor(pos.x, pos.y);
-
-            // write the screen data
-            display.write_screen_data(buffer, sizeof(buffer));
+        void write_rect(hwlib::location pos, hwlib::location size, const uint8_t *data) override {
+            // the width of a line in the data before clipping
+            const int_fast16_t stride = size.x;
+            const hwlib::location start = pos;
 
-            // update the cursor
-            if (x < (width - 1)) {
-                // increment the row to the next
-                x++;
+            if (!clip(pos, size)) {
+                return;
             }
-            else if (y < (height - 1)) {
-                // reset the x cursor position
-                x = 0;
 
-                // change cursor to the beginning 
-                display.set_column_address(0, width - 1);
+            // skip the lines and pixels of the data that are not on the screen
+            data += ((pos.y - start.y) * stride + (pos.x - start.x)) * 2;
 
-                // increment the column to the next
-                y++;
+            if (size.x == stride) {
+                // write the whole rectangle at once
+                display.write_rect(pos.x, pos.y, size.x, size.y, data);
             }
             else {
-                // we reached the end of the screen reset the row and column
-                x = 0;
-                y = 0;
-
-                // set the cursor to the start
-                display.set_column_address(0, width - 1);
-                display.set_row_address(0, height - 1);
+                // the lines are not next to each other anymore. Write every line
+                for (int_fast16_t y = 0; y < size.y; y++) {
+                    display.write_rect(pos.x, pos.y + y, size.x, 1, data + (y * stride * 2));
+                }
             }
+
+            // the address window changed. Invalidate the cursor so the next
+            // pixel write sets the full address window again
+            x = 0xFF;
+            y = 0xFF;
         }
 
+        // the fill with a hwlib color of the window
+        using hwlib_ssd1351::fill_rect;
+
         /**
-         * @brief clears the screen
+         * @brief Fill a rectangle on the screen with a color that is already in
+         * the screen format
          * 
-         * @param buf 
+         * @details Only the part of the rectangle on the screen is filled
+         * 
+         * @param pos the top left location of the rectangle
+         * @param size the width and height of the rectangle
+         * @param col the color to fill the rectangle with
          */
-        void clear(hwlib::buffering buf = hwlib::buffering::unbuffered) override {
-            // get binary data from a color
-            uint16_t color = color_to_data(window::background);
-
-            // convert the uint16_t to a array
-            uint8_t buffer[2] = {uint8_t(color >> 8), uint8_t(color & 0xFF)};
+        void fill_rect(hwlib::location pos, hwlib::location size, rgb565 col) override {
+            if (!clip(pos, size)) {
+                return;
+            }
 
-            // update the screen cursor
-            set_cursor(0, 0);
+            // fill the whole rectangle at once
+            display.fill_rect(pos.x, pos.y, size.x, size.y, col.value);
 
-            // loop over all the pixels in the screen
-            for (uint16_t i = 0; i < (height * width); i++) {
-                // write the color to the screen
-                display.write_screen_data(buffer, sizeof(buffer));
-            }
+            // the address window changed. Invalidate the cursor so the next
+            // pixel write sets the full address window again
+            x = 0xFF;
+            y = 0xFF;
         }
 
         /**
          * @brief flushes the screen.
          * 
-         * @warning Not implemented as a buffer is needed for this.
+         * @details Every write is already on the screen. Only ends the batch of 
+         * writes on the spi bus.
          * 
          */
         void flush() override {
-            // do nothjing
+            // release the chip select of the screen
+            display.end_batch();
         }      
 };
 
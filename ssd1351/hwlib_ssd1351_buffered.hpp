@@ -0,0 +1,359 @@
+#ifndef HWLIB_SSD1351_BUFFERED_HPP
+#define HWLIB_SSD1351_BUFFERED_HPP
+
+#include <hwlib.hpp>
+#include "hwlib_ssd1351.hpp"
+
+/**
+ * @brief Get the framebuffer of the buffered windows
+ *
+ * @details The framebuffer is 32KB and does not fit on the stack. Every 
+ * buffered window uses the same framebuffer, whatever driver it is bound to.
+ *
+ * @return uint16_t*
+ */
+inline uint16_t *hwlib_ssd1351_framebuffer() {
+    static uint16_t buffer[hwlib_ssd1351::width * hwlib_ssd1351::height];
+
+    return buffer;
+}
+
+/**
+ * @brief Buffered ssd1351 window
+ *
+ * @details All the writes land in a 128x128 framebuffer in ram. Flush only sends
+ * the rectangles that changed since the last flush to the screen.
+ *
+ * @warning There is only one framebuffer. Only create one buffered window.
+ *
+ * @tparam Driver ssd1351_t with the bus and the pin types of the screen
+ */
+template <typename Driver>
+class hwlib_ssd1351_buffered_t: public hwlib_ssd1351_t<Driver> {
+    protected:
+        // the members of the window we use
+        using hwlib_ssd1351_t<Driver>::display;
+        using hwlib_ssd1351::width;
+        using hwlib_ssd1351::height;
+        using hwlib_ssd1351::color_to_data;
+        using hwlib_ssd1351::clip;
+
+        /**
+         * @brief Rectangle on the screen that needs to be send on the next flush
+         *
+         */
+        struct rect {
+            // top left position (inclusive)
+            uint8_t x0;
+            uint8_t y0;
+
+            // bottom right position (inclusive)
+            uint8_t x1;
+            uint8_t y1;
+
+            // if the whole rectangle has a single color. These are send using
+            // a fill instead of the data in the framebuffer
+            bool solid;
+
+            // the color of a solid rectangle in screen format
+            uint16_t color;
+
+            /**
+             * @brief Get the amount of pixels in the rectangle
+             *
+             * @return uint32_t
+             */
+            uint32_t area() const {
+                return uint32_t(x1 - x0 + 1) * (y1 - y0 + 1);
+            }
+
+            /**
+             * @brief Get the smallest rectangle that contains this and another rectangle
+             *
+             * @param other
+             * @return rect
+             */
+            rect merge(const rect &other) const {
+                rect ret = {
+                    x0 < other.x0 ? x0 : other.x0, y0 < other.y0 ? y0 : other.y0,
+                    x1 > other.x1 ? x1 : other.x1, y1 > other.y1 ? y1 : other.y1,
+                    false, 0
+                };
+
+                // the result is only solid when both are the same color and 
+                // there are no pixels in the result that are not in one of them
+                if (solid && other.solid && color == other.color && 
+                    ret.area() == area() + other.area() - overlap(other)) {
+                    ret.solid = true;
+                    ret.color = color;
+                }
+
+                return ret;
+            }
+
+            /**
+             * @brief Get the amount of pixels that are in both rectangles
+             * 
+             * @param other 
+             * @return uint32_t 
+             */
+            uint32_t overlap(const rect &other) const {
+                const uint8_t left = x0 > other.x0 ? x0 : other.x0;
+                const uint8_t top = y0 > other.y0 ? y0 : other.y0;
+                const uint8_t right = x1 < other.x1 ? x1 : other.x1;
+                const uint8_t bottom = y1 < other.y1 ? y1 : other.y1;
+
+                if (left > right || top > bottom) {
+                    return 0;
+                }
+
+                return uint32_t(right - left + 1) * (bottom - top + 1);
+            }
+        };
+
+        // maximum amount of dirty rectangles we keep track of
+        constexpr static uint8_t max_dirty = 8;
+
+        // amount of pixels we are allowed to send extra when merging two rectangles.
+        // Sending a few pixels more is cheaper than setting a new address window
+        constexpr static uint16_t merge_slack = 32;
+
+        // the rectangles that changed since the last flush
+        rect dirty[max_dirty];
+
+        // amount of valid rectangles in dirty
+        uint8_t dirty_count;
+
+        // framebuffer with all the pixels. Stored as 16 bit words in the screen
+        // format so a part can be send with 16 bit transfers without converting
+        uint16_t *framebuffer;
+
+        /**
+         * @brief Add a rectangle to the list of changed rectangles
+         *
+         * @param pos
+         * @param size
+         * @param solid if the whole rectangle is written with a single color
+         * @param color the color of a solid rectangle in screen format
+         */
+        void mark_dirty(const hwlib::location pos, const hwlib::location size, 
+                        const bool solid = false, const uint16_t color = 0) {
+            rect r = {
+                uint8_t(pos.x), uint8_t(pos.y),
+                uint8_t(pos.x + size.x - 1), uint8_t(pos.y + size.y - 1),
+                solid, color
+            };
+
+            // a solid rectangle that gets other data is not solid anymore
+            for (uint8_t i = 0; i < dirty_count; i++) {
+                if (dirty[i].solid && dirty[i].overlap(r) && 
+                    (!r.solid || r.color != dirty[i].color)) {
+                    dirty[i].solid = false;
+                }
+            }
+
+            // check if we can merge the rectangle with one we already have
+            for (uint8_t i = 0; i < dirty_count; i++) {
+                const rect merged = dirty[i].merge(r);
+
+                // merge if sending the extra pixels is cheaper than a new window
+                if (merged.area() <= dirty[i].area() + r.area() + merge_slack) {
+                    dirty[i] = merged;
+
+                    return;
+                }
+            }
+
+            // check if we still have space for a new rectangle
+            if (dirty_count < max_dirty) {
+                dirty[dirty_count++] = r;
+
+                return;
+            }
+
+            // no space left. Merge with the rectangle that grows the least
+            uint8_t best = 0;
+            uint32_t best_growth = 0xFFFFFFFF;
+
+            for (uint8_t i = 0; i < dirty_count; i++) {
+                const uint32_t growth = dirty[i].merge(r).area() - dirty[i].area();
+
+                if (growth < best_growth) {
+                    best = i;
+                    best_growth = growth;
+                }
+            }
+
+            dirty[best] = dirty[best].merge(r);
+        }
+
+        /**
+         * @brief Fill a part of the framebuffer with a single color
+         *
+         * @param pos
+         * @param size
+         * @param data color in screen format
+         */
+        void fill_buffer(const hwlib::location pos, const hwlib::location size, const uint16_t data) {
+            for (int_fast16_t y = pos.y; y < pos.y + size.y; y++) {
+                uint16_t *line = framebuffer + (y * width);
+
+                for (int_fast16_t x = pos.x; x < pos.x + size.x; x++) {
+                    line[x] = data;
+                }
+            }
+        }
+
+    public:
+        hwlib_ssd1351_buffered_t(typename Driver::bus_type & spi, typename Driver::reset_type & reset, 
+                                 typename Driver::dc_type & dc, typename Driver::cs_type & cs):
+            hwlib_ssd1351_t<Driver>(spi, reset, dc, cs),
+            dirty_count(0), framebuffer(hwlib_ssd1351_framebuffer())
+        {}
+
+        /**
+         * @brief Write a single pixel to the framebuffer
+         *
+         * @details Every write is buffered. Call flush to send it to the screen.
+         *
+         * @param pos the location of the pixel
+         * @param col the color of the pixel
+         */
+        void write_pixel(hwlib::location pos, rgb565 col) override {
+            // skip the pixels that are not on the screen
+            if (pos.x < 0 || pos.y < 0 || pos.x >= width || pos.y >= height) {
+                return;
+            }
+
+            // write the pixel to the framebuffer
+            framebuffer[pos.x + pos.y * width] = col.value;
+
+            // mark the pixel as changed
+            mark_dirty(pos, hwlib::location(1, 1));
+        }
+
+        /**
+         * @brief Write a rectangle of pixel data to the framebuffer
+         *
+         * @param pos the top left location of the rectangle
+         * @param size the width and height of the rectangle
+         * @param data pixel data (2 bytes per pixel, high byte first). Needs
+         * size.x * size.y * 2 bytes
+         */
+        void write_rect(hwlib::location pos, hwlib::location size, const uint8_t *data) override {
+            // the width of a line in the data before clipping
+            const int_fast16_t stride = size.x;
+            const hwlib::location start = pos;
+
+            if (!clip(pos, size)) {
+                return;
+            }
+
+            // skip the lines and pixels of the data that are not on the screen
+            data += ((pos.y - start.y) * stride + (pos.x - start.x)) * 2;
+
+            // copy every line to the framebuffer
+            for (int_fast16_t y = 0; y < size.y; y++) {
+                uint16_t *line = framebuffer + ((pos.y + y) * width) + pos.x;
+                const uint8_t *source = data + (y * stride * 2);
+
+                for (int_fast16_t x = 0; x < size.x; x++) {
+                    line[x] = uint16_t(source[x * 2] << 8) | source[x * 2 + 1];
+                }
+            }
+
+            // mark the rectangle as changed
+            mark_dirty(pos, size);
+        }
+
+        // the fill with a hwlib color of the window
+        using hwlib_ssd1351::fill_rect;
+
+        /**
+         * @brief Fill a rectangle in the framebuffer with a single color
+         *
+         * @param pos the top left location of the rectangle
+         * @param size the width and height of the rectangle
+         * @param col the color to fill the rectangle with
+         */
+        void fill_rect(hwlib::location pos, hwlib::location size, rgb565 col) override {
+            if (!clip(pos, size)) {
+                return;
+            }
+
+            // fill the rectangle in the framebuffer
+            fill_buffer(pos, size, col.value);
+
+            // mark the rectangle as changed. It can be send using a fill
+            mark_dirty(pos, size, true, col.value);
+        }
+
+        /**
+         * @brief clears the framebuffer
+         *
+         * @param buf ignored. Every write is buffered
+         */
+        void clear(hwlib::buffering buf = hwlib::buffering::unbuffered) override {
+            // get binary data from a color
+            const rgb565 data = color_to_data(this->background);
+
+            // fill the whole framebuffer with the background
+            fill_buffer(hwlib::location(0, 0), hwlib::location(width, height),
+                        data.value);
+
+            // everything changed. Replace all the rectangles with a single
+            // fill of the full screen
+            dirty[0] = {0, 0, width - 1, height - 1, true, data.value};
+            dirty_count = 1;
+        }
+
+        /**
+         * @brief Send all the changed rectangles to the screen
+         *
+         * @details The rectangles are added to the queue of the spi bus and written
+         * from the interrupt when the bus supports it. Flush can return before
+         * everything is on the screen. Writes to the framebuffer in the meantime
+         * are marked dirty again and send on the next flush.
+         *
+         */
+        void flush() override {
+            // send every changed rectangle
+            for (uint8_t i = 0; i < dirty_count; i++) {
+                const rect &r = dirty[i];
+
+                // check if we can fill the rectangle without sending the framebuffer
+                if (r.solid) {
+                    display.enqueue_fill_rect(r.x0, r.y0, r.x1 - r.x0 + 1, r.y1 - r.y0 + 1, r.color);
+
+                    continue;
+                }
+
+                // queue the part of the framebuffer with one address window
+                display.enqueue_rect(
+                    r.x0, r.y0, r.x1 - r.x0 + 1, r.y1 - r.y0 + 1,
+                    framebuffer + (r.y0 * width) + r.x0, width
+                );
+            }
+
+            // release the chip select after the last rectangle
+            display.enqueue_end_batch();
+
+            // everything is on the screen
+            dirty_count = 0;
+        }
+};
+
+/**
+ * @brief Buffered ssd1351 window with a runtime spi bus and runtime pins
+ *
+ * @details Works with every hwlib pin and every spi_bus_extended
+ *
+ */
+class hwlib_ssd1351_buffered: public hwlib_ssd1351_buffered_t<ssd1351> {
+    public:
+        hwlib_ssd1351_buffered(spi_bus_extended & spi, hwlib::pin_out & reset, hwlib::pin_out & dc, hwlib::pin_out & cs):
+            hwlib_ssd1351_buffered_t(spi, reset, dc, cs)
+        {}
+};
+
+#endif
@@ -0,0 +1,102 @@
+#ifndef RGB565_HPP
+#define RGB565_HPP
+
+#include <stdint.h>
+#include <hwlib.hpp>
+
+/**
+ * @brief 16 bit color in the native format of the screen
+ *
+ * @details 5 bits red, 6 bits green and 5 bits blue. Converting is done once
+ * when the color is created (at compile time for constants) so writing a
+ * pixel does not need any divides.
+ *
+ */
+class rgb565 {
+    public:
+        // the color in screen format
+        uint16_t value;
+
+        /**
+         * @brief Construct a black color
+         *
+         */
+        constexpr rgb565():
+            value(0)
+        {}
+
+        /**
+         * @brief Construct a color from data that is already in screen format
+         *
+         * @param value
+         */
+        constexpr explicit rgb565(const uint16_t value):
+            value(value)
+        {}
+
+        /**
+         * @brief Construct a color from 8 bit red, green and blue values
+         *
+         * @param red
+         * @param green
+         * @param blue
+         */
+        constexpr rgb565(const uint8_t red, const uint8_t green, const uint8_t blue):
+            value(uint16_t(
+                (((uint16_t(red) * 0x1F) / 0xFF) << 11) |
+                (((uint16_t(green) * 0x3F) / 0xFF) << 5) |
+                ((uint16_t(blue) * 0x1F) / 0xFF)
+            ))
+        {}
+
+        /**
+         * @brief Construct a color from a hwlib color
+         *
+         * @param color
+         */
+        constexpr rgb565(const hwlib::color &color):
+            rgb565(color.red, color.green, color.blue)
+        {}
+
+        /**
+         * @brief Get the high byte that is send first to the screen
+         *
+         * @return uint8_t
+         */
+        constexpr uint8_t high() const {
+            return uint8_t(value >> 8);
+        }
+
+        /**
+         * @brief Get the low byte that is send last to the screen
+         *
+         * @return uint8_t
+         */
+        constexpr uint8_t low() const {
+            return uint8_t(value & 0xFF);
+        }
+
+        constexpr bool operator==(const rgb565 &other) const {
+            return value == other.value;
+        }
+
+        constexpr bool operator!=(const rgb565 &other) const {
+            return value != other.value;
+        }
+};
+
+/**
+ * @brief The hwlib named colors converted at compile time
+ *
+ */
+namespace color565 {
+    constexpr rgb565 black(hwlib::black);
+    constexpr rgb565 white(hwlib::white);
+    constexpr rgb565 red(hwlib::red);
+    constexpr rgb565 green(hwlib::green);
+    constexpr rgb565 blue(hwlib::blue);
+    constexpr rgb565 gray(hwlib::gray);
+    constexpr rgb565 yellow(hwlib::yellow);
+}
+
+#endif
@@ -3,24 +3,41 @@
 
 #include <stdint.h>
 #include "hwlib.hpp"
+#include "spi_bus_extended.hpp"
 
 /**
  * @brief SSD1351 Library
  * 
+ * @details The bus and the pins are bound at compile time. When the types are
+ * final (like hwspi and due_pin_out) every byte push and pin change is a direct
+ * call that can be inlined instead of a virtual call.
+ * 
+ * @tparam Bus spi bus with the spi_bus_extended functions
+ * @tparam Dc data/command pin type
+ * @tparam Cs chip select pin type
+ * @tparam Reset reset pin type
  */
-class ssd1351{
+template <typename Bus, typename Dc, typename Cs, typename Reset>
+class ssd1351_t {
+    public:
+        // the types the driver is bound to
+        using bus_type = Bus;
+        using dc_type = Dc;
+        using cs_type = Cs;
+        using reset_type = Reset;
+
     protected:  
-        // hwlib spi bus 
-        hwlib::spi_bus &spi;
+        // spi bus 
+        Bus &spi;
         
         // reset pin for the oled screen
-        hwlib::pin_out &reset;
+        Reset &reset;
         
         // data/command pin for the screen
-        hwlib::pin_out &dc; 
+        Dc &dc; 
         
         // chip select pin of the screen
-        hwlib::pin_out &cs;
+        Cs &cs;
 
         void write_command(const uint8_t *data, const uint32_t size);
 
@@ -30,17 +47,43 @@ class ssd1351{
 
         void write_data(const uint8_t data);   
 
+        /**
+         * @brief Write pixel data with the fastest clock of the spi bus
+         * 
+         * @param data pixel data to write
+         * @param size amount of bytes to write
+         */
+        void write_pixels(const uint8_t *data, const uint32_t size);
+
+        /**
+         * @brief Write the same 16 bit data multiple times
+         * 
+         * @param data data to repeat (send high byte first)
+         * @param count amount of times the data is written
+         */
+        void write_data_repeat(const uint16_t data, const uint32_t count);
+
+        /**
+         * @brief Add a small write to the queue of the spi bus
+         * 
+         * @details The data is copied in the transaction
+         * 
+         * @param dc level of the data/command pin
+         * @param data data to write
+         * @param size amount of bytes in the data (max 4)
+         */
+        void enqueue_inline(const bool dc, const uint8_t *data, const uint8_t size);
+
     public:
         /**
-         * @brief Construct a new ssd1351 object
+         * @brief Construct a new ssd1351_t object
          * 
          * @param spi the spi bus
          * @param reset the reset pin
          * @param dc the data/command pin
          * @param cs the chip select pin
          */
-        ssd1351(hwlib::spi_bus &spi, hwlib::pin_out &reset, 
-                hwlib::pin_out &dc, hwlib::pin_out &cs);
+        ssd1351_t(Bus &spi, Reset &reset, Dc &dc, Cs &cs);
 
         /**
          * @brief Write screen data to the screen
@@ -50,6 +93,155 @@ class ssd1351{
          */
         void write_screen_data(uint8_t *data, uint32_t size);
 
+        /**
+         * @brief Set the address window of the screen
+         * 
+         * @details Sets the column and row address so the next screen data is written
+         * in the rectangle
+         * 
+         * @param x start column of the window
+         * @param y start row of the window
+         * @param w width of the window. Should not be 0
+         * @param h height of the window. Should not be 0
+         */
+        void set_address_window(const uint8_t x, const uint8_t y, const uint8_t w, const uint8_t h);
+
+        /**
+         * @brief Write a rectangle of screen data to the screen
+         * 
+         * @details Sets the address window once, sends a single 0x5C and streams all 
+         * the pixels in one spi transaction
+         * 
+         * @param x start column of the rectangle
+         * @param y start row of the rectangle
+         * @param w width of the rectangle
+         * @param h height of the rectangle. Nothing is written when w or h is 0
+         * @param data pixel data (2 bytes per pixel, high byte first). Needs w * h * 2 bytes
+         */
+        void write_rect(const uint8_t x, const uint8_t y, const uint8_t w, const uint8_t h, 
+                        const uint8_t *data);
+
+        /**
+         * @brief Write a rectangle of screen data from a larger image to the screen
+         * 
+         * @details Sets the address window once, sends a single 0x5C and streams every 
+         * line of the rectangle. Used to send a part of a framebuffer.
+         * 
+         * @param x start column of the rectangle
+         * @param y start row of the rectangle
+         * @param w width of the rectangle
+         * @param h height of the rectangle. Nothing is written when w or h is 0
+         * @param data 16 bit pixel data of the first pixel
+         * @param stride amount of pixels between the start of two lines in the data
+         */
+        void write_rect(const uint8_t x, const uint8_t y, const uint8_t w, const uint8_t h, 
+                        const uint16_t *data, const uint32_t stride);
+
+        /**
+         * @brief Start writing a rectangle of screen data from a larger image
+         * 
+         * @details Returns when the pixel data is started. The data should stay valid 
+         * until the callback is called or wait returns. Every other call on the 
+         * screen waits until the write is done.
+         * 
+         * @param x start column of the rectangle
+         * @param y start row of the rectangle
+         * @param w width of the rectangle
+         * @param h height of the rectangle. Nothing is written when w or h is 0
+         * @param data 16 bit pixel data of the first pixel
+         * @param stride amount of pixels between the start of two lines in the data
+         * @param callback called when all the pixels are written. Can be called from
+         * a interrupt
+         */
+        void write_rect_async(const uint8_t x, const uint8_t y, const uint8_t w, const uint8_t h, 
+                              const uint16_t *data, const uint32_t stride, 
+                              void (*callback)() = nullptr);
+
+        /**
+         * @brief Add a command to the queue of the spi bus
+         * 
+         * @param command command to write
+         */
+        void enqueue_command(const uint8_t command);
+
+        /**
+         * @brief Add data to the queue of the spi bus
+         * 
+         * @param data data to write. Should stay valid until wait returns
+         * @param size amount of bytes to write
+         */
+        void enqueue_data(const uint8_t *data, const uint32_t size);
+
+        /**
+         * @brief Add setting the address window to the queue of the spi bus
+         * 
+         * @param x start column of the window
+         * @param y start row of the window
+         * @param w width of the window. Should not be 0
+         * @param h height of the window. Should not be 0
+         */
+        void enqueue_address_window(const uint8_t x, const uint8_t y, const uint8_t w, const uint8_t h);
+
+        /**
+         * @brief Add a rectangle of screen data from a larger image to the queue 
+         * of the spi bus
+         * 
+         * @param x start column of the rectangle
+         * @param y start row of the rectangle
+         * @param w width of the rectangle
+         * @param h height of the rectangle. Nothing is written when w or h is 0
+         * @param data 16 bit pixel data of the first pixel. Should stay valid until 
+         * wait returns
+         * @param stride amount of pixels between the start of two lines in the data
+         */
+        void enqueue_rect(const uint8_t x, const uint8_t y, const uint8_t w, const uint8_t h, 
+                          const uint16_t *data, const uint32_t stride);
+
+        /**
+         * @brief Add filling a rectangle with a single color to the queue of the spi bus
+         * 
+         * @param x start column of the rectangle
+         * @param y start row of the rectangle
+         * @param w width of the rectangle
+         * @param h height of the rectangle. Nothing is written when w or h is 0
+         * @param color 16 bit color to fill the rectangle with
+         */
+        void enqueue_fill_rect(const uint8_t x, const uint8_t y, const uint8_t w, const uint8_t h, 
+                               const uint16_t color);
+
+        /**
+         * @brief Release the chip select after a batch of writes
+         * 
+         * @details Waits until all the writes are done
+         * 
+         */
+        void end_batch();
+
+        /**
+         * @brief Add releasing the chip select after the queued writes to the queue
+         * of the spi bus
+         * 
+         */
+        void enqueue_end_batch();
+
+        /**
+         * @brief Wait until a asynchronous write and all the queued writes are done
+         * 
+         */
+        void wait();
+
+        /**
+         * @brief Fill a rectangle on the screen with a single color
+         * 
+         * @param x start column of the rectangle
+         * @param y start row of the rectangle
+         * @param w width of the rectangle
+         * @param h height of the rectangle. Nothing is written when w or h is 0
+         * @param color 16 bit color to fill the rectangle with
+         */
+        void fill_rect(const uint8_t x, const uint8_t y, const uint8_t w, const uint8_t h, 
+                       const uint16_t color);
+
         /**
          * @brief set clock divider
          * 
@@ -234,4 +426,585 @@ class ssd1351{
         void set_second_precharge(const uint8_t precharge);
 };
 
-#endif
\ No newline at end of file
+template <typename Bus, typename Dc, typename Cs, typename Reset>
+ssd1351_t<Bus, Dc, Cs, Reset>::ssd1351_t(Bus & spi, Reset & reset, Dc & dc, Cs & cs): spi(spi), reset(reset), dc(dc), cs(cs) {
+    // wake the oled screen for the reset
+    cs.set(false); 
+
+    // reset the oled screen
+    reset.set(true);
+
+    // wait a bit for the oled screen to register the cs update
+    hwlib::wait_ms(10);
+
+    // reset the oled screen (resets when reset is low)
+    reset.set(false); 
+
+    // wait a bit until the oled screen has fully resetted
+    hwlib::wait_ms(10);
+
+    // clear the reset
+    reset.set(true);
+
+    // wait a bit for the oled screen to turn back on
+    hwlib::wait_ms(10);
+}
+
+template <typename Bus, typename Dc, typename Cs, typename Reset>
+void ssd1351_t<Bus, Dc, Cs, Reset>::write_command(const uint8_t *data, const uint32_t size) {
+    // wait until a asynchronous write is done before changing the dc pin
+    spi.wait();
+
+    // clear the dc pin for a command
+    dc.set(false);
+
+    // commands use the conservative clock
+    spi.select_profile(spi_profile::command);
+
+    //Write commands to the spi interface
+    spi.write_and_read(cs , size, data, nullptr);
+}
+
+template <typename Bus, typename Dc, typename Cs, typename Reset>
+void ssd1351_t<Bus, Dc, Cs, Reset>::write_data(const uint8_t *data, const uint32_t size) {
+    // wait until a asynchronous write is done before changing the dc pin
+    spi.wait();
+
+    // set the dc pin for data
+    dc.set(true);
+
+    // command parameters use the conservative clock
+    spi.select_profile(spi_profile::command);
+
+    //Write data to the spi interface
+    spi.write_and_read(cs , size, data, nullptr);
+}
+
+template <typename Bus, typename Dc, typename Cs, typename Reset>
+void ssd1351_t<Bus, Dc, Cs, Reset>::write_pixels(const uint8_t *data, const uint32_t size) {
+    // wait until a asynchronous write is done before changing the dc pin
+    spi.wait();
+
+    // set the dc pin for data
+    dc.set(true);
+
+    // pixel data uses the fastest clock
+    spi.select_profile(spi_profile::data);
+
+    // write the pixels to the spi interface
+    spi.write_and_read(cs , size, data, nullptr);
+}
+
+template <typename Bus, typename Dc, typename Cs, typename Reset>
+void ssd1351_t<Bus, Dc, Cs, Reset>::write_data_repeat(const uint16_t data, const uint32_t count) {
+    // wait until a asynchronous write is done before changing the dc pin
+    spi.wait();
+
+    // set the dc pin for data
+    dc.set(true);
+
+    // pixel data uses the fastest clock
+    spi.select_profile(spi_profile::data);
+
+    // let the spi bus repeat the data
+    spi.write_repeat16(cs, data, count);
+}
+
+template <typename Bus, typename Dc, typename Cs, typename Reset>
+void ssd1351_t<Bus, Dc, Cs, Reset>::write_command(const uint8_t data) {
+    write_command(&data, 1);
+}
+
+template <typename Bus, typename Dc, typename Cs, typename Reset>
+void ssd1351_t<Bus, Dc, Cs, Reset>::write_data(const uint8_t data) {
+    write_data(&data, 1);
+}
+
+template <typename Bus, typename Dc, typename Cs, typename Reset>
+void ssd1351_t<Bus, Dc, Cs, Reset>::write_screen_data(uint8_t *data, uint32_t size) {
+    // 0x5C = command for screen data
+    write_command(0x5C);
+
+    // write the display data
+    write_pixels(data, size);
+}
+
+template <typename Bus, typename Dc, typename Cs, typename Reset>
+void ssd1351_t<Bus, Dc, Cs, Reset>::set_address_window(const uint8_t x, const uint8_t y, const uint8_t w, const uint8_t h) {
+    // set the column and row address to the rectangle
+    set_column_address(x, x + w - 1);
+    set_row_address(y, y + h - 1);
+}
+
+template <typename Bus, typename Dc, typename Cs, typename Reset>
+void ssd1351_t<Bus, Dc, Cs, Reset>::write_rect(const uint8_t x, const uint8_t y, const uint8_t w, const uint8_t h, 
+                                               const uint8_t *data) {
+    // a empty rectangle has no pixels and no valid window
+    if (!w || !h) {
+        return;
+    }
+
+    // set the window we want to write to
+    set_address_window(x, y, w, h);
+
+    // 0x5C = command for screen data
+    write_command(0x5C);
+
+    // write all the pixels in one go
+    write_pixels(data, uint32_t(w) * h * 2);
+}
+
+template <typename Bus, typename Dc, typename Cs, typename Reset>
+void ssd1351_t<Bus, Dc, Cs, Reset>::write_rect(const uint8_t x, const uint8_t y, const uint8_t w, const uint8_t h, 
+                                               const uint16_t *data, const uint32_t stride) {
+    // a empty rectangle has no pixels and no valid window
+    if (!w || !h) {
+        return;
+    }
+
+    // start writing the rectangle
+    write_rect_async(x, y, w, h, data, stride);
+
+    // wait until everything is written
+    spi.wait();
+}
+
+template <typename Bus, typename Dc, typename Cs, typename Reset>
+void ssd1351_t<Bus, Dc, Cs, Reset>::write_rect_async(const uint8_t x, const uint8_t y, const uint8_t w, const uint8_t h, 
+                                                     const uint16_t *data, const uint32_t stride, void (*callback)()) {
+    // a empty rectangle has no pixels and no valid window. It is done right away
+    if (!w || !h) {
+        if (callback) {
+            callback();
+        }
+
+        return;
+    }
+
+    // set the window we want to write to
+    set_address_window(x, y, w, h);
+
+    // 0x5C = command for screen data
+    write_command(0x5C);
+
+    // wait until a asynchronous write is done before changing the dc pin
+    spi.wait();
+
+    // set the dc pin for data
+    dc.set(true);
+
+    // pixel data uses the fastest clock
+    spi.select_profile(spi_profile::data);
+
+    // check if the lines are next to each other in memory
+    if (stride == w) {
+        // write everything as a single line
+        spi.write_lines16_async(cs, uint32_t(w) * h, data, stride, 1, callback);
+    }
+    else {
+        // let the bus write every line of the rectangle
+        spi.write_lines16_async(cs, w, data, stride, h, callback);
+    }
+}
+
+template <typename Bus, typename Dc, typename Cs, typename Reset>
+void ssd1351_t<Bus, Dc, Cs, Reset>::enqueue_inline(const bool dc, const uint8_t *data, const uint8_t size) {
+    spi_transaction transaction = {};
+
+    // copy the data in the transaction
+    for (uint8_t i = 0; i < size; i++) {
+        transaction.inline_data[i] = data[i];
+    }
+
+    transaction.dc = &this->dc;
+    transaction.dc_level = dc;
+    transaction.size = size;
+    transaction.lines = 1;
+
+    spi.enqueue(cs, transaction);
+}
+
+template <typename Bus, typename Dc, typename Cs, typename Reset>
+void ssd1351_t<Bus, Dc, Cs, Reset>::enqueue_command(const uint8_t command) {
+    enqueue_inline(false, &command, 1);
+}
+
+template <typename Bus, typename Dc, typename Cs, typename Reset>
+void ssd1351_t<Bus, Dc, Cs, Reset>::enqueue_data(const uint8_t *data, const uint32_t size) {
+    spi_transaction transaction = {};
+
+    transaction.dc = &dc;
+    transaction.dc_level = true;
+    transaction.size = size;
+    transaction.lines = 1;
+    transaction.data = data;
+
+    spi.enqueue(cs, transaction);
+}
+
+template <typename Bus, typename Dc, typename Cs, typename Reset>
+void ssd1351_t<Bus, Dc, Cs, Reset>::enqueue_address_window(const uint8_t x, const uint8_t y, const uint8_t w, const uint8_t h) {
+    // 0x15 = command for setting the column 
+    enqueue_command(0x15);
+
+    const uint8_t column[] = {uint8_t(x & 0x7F), uint8_t((x + w - 1) & 0x7F)};
+    enqueue_inline(true, column, sizeof(column));
+
+    // 0x75 = command for setting the row
+    enqueue_command(0x75);
+
+    const uint8_t row[] = {uint8_t(y & 0x7F), uint8_t((y + h - 1) & 0x7F)};
+    enqueue_inline(true, row, sizeof(row));
+}
+
+template <typename Bus, typename Dc, typename Cs, typename Reset>
+void ssd1351_t<Bus, Dc, Cs, Reset>::enqueue_rect(const uint8_t x, const uint8_t y, const uint8_t w, const uint8_t h, 
+                                                 const uint16_t *data, const uint32_t stride) {
+    // a empty rectangle has no pixels and no valid window
+    if (!w || !h) {
+        return;
+    }
+
+    // set the window we want to write to
+    enqueue_address_window(x, y, w, h);
+
+    // 0x5C = command for screen data
+    enqueue_command(0x5C);
+
+    spi_transaction transaction = {};
+
+    transaction.dc = &dc;
+    transaction.dc_level = true;
+    transaction.words = true;
+    transaction.profile = spi_profile::data;
+    transaction.data = data;
+
+    // check if the lines are next to each other in memory
+    if (stride == w) {
+        // write everything as a single line
+        transaction.size = uint16_t(w) * h;
+        transaction.lines = 1;
+    }
+    else {
+        // let the bus write every line of the rectangle
+        transaction.size = w;
+        transaction.stride = stride;
+        transaction.lines = h;
+    }
+
+    spi.enqueue(cs, transaction);
+}
+
+template <typename Bus, typename Dc, typename Cs, typename Reset>
+void ssd1351_t<Bus, Dc, Cs, Reset>::enqueue_fill_rect(const uint8_t x, const uint8_t y, const uint8_t w, const uint8_t h, 
+                                                      const uint16_t color) {
+    // a empty rectangle has no pixels and no valid window
+    if (!w || !h) {
+        return;
+    }
+
+    // set the window we want to write to
+    enqueue_address_window(x, y, w, h);
+
+    // 0x5C = command for screen data
+    enqueue_command(0x5C);
+
+    spi_transaction transaction = {};
+
+    // repeat the color for every pixel in the rectangle
+    transaction.dc = &dc;
+    transaction.dc_level = true;
+    transaction.words = true;
+    transaction.profile = spi_profile::data;
+    transaction.size = 1;
+    transaction.stride = 0;
+    transaction.lines = uint32_t(w) * h;
+    
+    *reinterpret_cast<uint16_t*>(transaction.inline_data) = color;
+
+    spi.enqueue(cs, transaction);
+}
+
+template <typename Bus, typename Dc, typename Cs, typename Reset>
+void ssd1351_t<Bus, Dc, Cs, Reset>::end_batch() {
+    // release the chip select
+    spi.end_batch(cs);
+}
+
+template <typename Bus, typename Dc, typename Cs, typename Reset>
+void ssd1351_t<Bus, Dc, Cs, Reset>::enqueue_end_batch() {
+    spi_transaction transaction = {};
+
+    // a empty transaction that releases the chip select when it is done
+    transaction.release_cs = true;
+
+    spi.enqueue(cs, transaction);
+}
+
+template <typename Bus, typename Dc, typename Cs, typename Reset>
+void ssd1351_t<Bus, Dc, Cs, Reset>::wait() {
+    // wait until the spi bus is done
+    spi.wait();
+}
+
+template <typename Bus, typename Dc, typename Cs, typename Reset>
+void ssd1351_t<Bus, Dc, Cs, Reset>::fill_rect(const uint8_t x, const uint8_t y, const uint8_t w, const uint8_t h, 
+                                              const uint16_t color) {
+    // a empty rectangle has no pixels and no valid window
+    if (!w || !h) {
+        return;
+    }
+
+    // set the window we want to write to
+    set_address_window(x, y, w, h);
+
+    // 0x5C = command for screen data
+    write_command(0x5C);
+
+    // repeat the color for every pixel in the rectangle
+    write_data_repeat(color, uint32_t(w) * h);
+}
+
+template <typename Bus, typename Dc, typename Cs, typename Reset>
+void ssd1351_t<Bus, Dc, Cs, Reset>::set_clock_divider(const uint8_t divider, const uint8_t frequency) {
+    // 0xB3 = command for changing the front clock divider
+    // d0:d3 = clock divider
+    // d4:d7 = oscillator frequency    
+    write_command(0xB3);
+
+    // write the clock divider
+    write_data((frequency << 4) | (divider & 0xF));
+}
+
+template <typename Bus, typename Dc, typename Cs, typename Reset>
+void ssd1351_t<Bus, Dc, Cs, Reset>::set_gpio(const uint8_t gpio) {
+    // 0xB5 = command for setting gpio
+    write_command(0xB5);
+
+    // write the states
+    write_data(gpio & 0x0F);
+}
+
+template <typename Bus, typename Dc, typename Cs, typename Reset>
+void ssd1351_t<Bus, Dc, Cs, Reset>::set_phase_lenght(const uint8_t phase1, const uint8_t phase2) {
+    // 0xB1 = command for changing phase periods
+    // A0:A3 = Phase 1 clocks
+    // A4:A7 = Phase 2 clocks    
+    write_command(0xB1);
+    // write the phase lengths
+    write_data(uint8_t((phase2 << 4) | (phase1 & 0x0F)));
+}
+
+template <typename Bus, typename Dc, typename Cs, typename Reset>
+void ssd1351_t<Bus, Dc, Cs, Reset>::set_display_offset(const uint8_t offset) {
+    // 0xA2 = command for display offset
+    write_command(0xA2);
+
+    // write the offset
+    write_data(offset & 0x7F);
+}
+
+template <typename Bus, typename Dc, typename Cs, typename Reset>
+void ssd1351_t<Bus, Dc, Cs, Reset>::set_display_startline(const uint8_t startline) {
+    // 0xA1 = command for setting the starting line
+    write_command(0xA1);
+    
+    // write the start line
+    write_data(startline & 0x7F);
+}
+
+template <typename Bus, typename Dc, typename Cs, typename Reset>
+void ssd1351_t<Bus, Dc, Cs, Reset>::set_interface_registers(const bool regulator, const uint8_t interface) {
+    // 0xAB = command to set the interface type and to enable and disable the internal regulator during sleep
+    // A0 = 0b0 = Disable internal regulator during sleep
+    // A0 = 0b1 = Enable internal regulator
+    // A6:7 = 0b00 = Select 8-bit parallel interface
+    // A6:7 = 0b01 = Select 16-bit parallel interface
+    // A6:7 = 0b11 = Select 18-bit parallel interface
+    write_command(0xAB);
+    
+    // write the interface and regulator
+    write_data(uint8_t((interface & 0x03) << 6 | regulator));
+}
+
+template <typename Bus, typename Dc, typename Cs, typename Reset>
+void ssd1351_t<Bus, Dc, Cs, Reset>::set_command_lock(const bool lock) {
+    // 0xFD = command for setting command lock without this unlocked the SSD1351 wont respond to commands and doesn't give memory access
+    // 0x12 = disable command lock
+    // 0x16 = enable command lock
+    write_command(0xFD);
+    
+    write_data(lock ? 0x16 : 0x12);
+}
+
+template <typename Bus, typename Dc, typename Cs, typename Reset>
+void ssd1351_t<Bus, Dc, Cs, Reset>::enable_power_options(const bool allow_commands) {
+    // Normaly you dont need these commands use with caution
+    // enable to use commands 0xA2, 0xB1, 0xB3, 0xBB, 0xBE, 0xC1 these commands are necessary certain operations look at the datasheet for more info
+    // 0xFD = command for setting command lock without this unlocked the SSD1351 wont respond to commands and doesn't give memory access
+    // 0xB0 = dont allow access to the commands
+    // 0xB1 = allow access to the commands
+    write_command(0xFD);
+    
+    write_data(0xB0 | uint8_t(allow_commands));
+}
+
+template <typename Bus, typename Dc, typename Cs, typename Reset>
+void ssd1351_t<Bus, Dc, Cs, Reset>::set_color_contrast(const uint8_t a, const uint8_t b, const uint8_t c) {
+    // 0xC1 = command for setting color contrast
+    // For this command you need to enable the poweroptions
+    write_command(0xC1);
+
+    uint8_t tmp[] = {a, b, c};
+    write_data(tmp, sizeof(tmp));
+}
+
+template <typename Bus, typename Dc, typename Cs, typename Reset>
+void ssd1351_t<Bus, Dc, Cs, Reset>::set_master_contrast(const uint8_t contrast) {
+    // 0xC7 = command for setting master contrast
+    // the higher M is the more the output current is limited
+    // 0x00 = reduce output currents for all color to 1/16
+    //        ...
+    // 0x0E = reduce output currents for all color to 15/16
+    // 0x0F = no change
+    write_command(0xC7);
+    
+    write_data(uint8_t(contrast & 0x0F));
+}
+
+template <typename Bus, typename Dc, typename Cs, typename Reset>
+void ssd1351_t<Bus, Dc, Cs, Reset>::set_mux_ratio(const uint8_t ratio) {
+    // 0xCA = command for mux ratio setting
+    write_command(0xCA);
+    
+    write_data(ratio & 0x7F);
+}
+
+template <typename Bus, typename Dc, typename Cs, typename Reset>
+void ssd1351_t<Bus, Dc, Cs, Reset>::set_column_address(const uint8_t start_address, const uint8_t end_address) {
+    // 0x15 = command for setting the column 
+    // second byte is start adress
+    // third byte is end adress
+    write_command(0x15);
+
+    uint8_t tmp[] = {uint8_t(start_address & 0x7F), uint8_t(end_address & 0x7F)};
+    write_data(tmp, sizeof(tmp));
+}
+
+template <typename Bus, typename Dc, typename Cs, typename Reset>
+void ssd1351_t<Bus, Dc, Cs, Reset>::set_row_address(const uint8_t start_address, const uint8_t end_address) {
+    // 0x75 = command for setting the row
+    // second byte is start adress
+    // third byte is end adress
+    write_command(0x75);
+
+    uint8_t tmp[] = {uint8_t(start_address & 0x7F), uint8_t(end_address & 0x7F)};
+    write_data(tmp, sizeof(tmp));
+}
+
+template <typename Bus, typename Dc, typename Cs, typename Reset>
+void ssd1351_t<Bus, Dc, Cs, Reset>::set_display_mode(const uint8_t mode) {
+    // 0xA4:0xA7 = commands for the display modes
+    // 0xA4 = All off
+    // 0xA5 = All on
+    // 0xA6 = reset to normal display
+    // 0xA7 = Inverse Display
+    write_command(uint8_t(0xA4 | (mode & 0x03)));
+}
+
+template <typename Bus, typename Dc, typename Cs, typename Reset>
+void ssd1351_t<Bus, Dc, Cs, Reset>::set_sleep_mode(const bool sleep) {
+    // 0xAE:0xAF = command for sleep state
+    // 0xAE = Sleep mode on
+    // 0xAF = Sleep mode off
+    write_command(0xAF - sleep);
+}
+
+template <typename Bus, typename Dc, typename Cs, typename Reset>
+void ssd1351_t<Bus, Dc, Cs, Reset>::set_re_co(const bool increment, const bool map, const bool sequence, const bool scan, 
+                                              const bool split, const uint8_t depth) {
+    // Set Remap/ Color depth
+    // A0 = 0b0 = Horizontal address increment
+    // A0 = 0b1 = Vertical address increment
+    // A1 = 0b0 = Column address 0 is mapped to SEG0
+    // A1 = 0b1 = Column address 127 is mapped to SEG0
+    // A2 = 0b0 = Color sequence A -> B -> C
+    // A2 = 0b1 = Color sequence C -> B -> A
+    // A3 = Reserved
+    // A4 = 0b0 Scan from COM0 to COM[n-1]
+    // A4 = 0b1 Scan from COM[n-1] to COM0
+    // A5 = 0b0 Disable COM split odd even
+    // A5 = 0b1 Enable COM split odd even
+    // A6:7 = 0b00 = 65K color depth
+    // A6:7 = 0b01 = 65K color depth
+    // A6:7 = 0b10 = 262K color depth
+    // A6:7 = 0b11 = 262K color depth, 16 bit format 2
+    write_command(0xA0);
+
+    // write the settings
+    write_data(((depth & 0x03) << 6) | (split << 5) | (scan << 4) | 
+               (sequence << 2) | (map << 1) | increment); 
+}
+
+template <typename Bus, typename Dc, typename Cs, typename Reset>
+void ssd1351_t<Bus, Dc, Cs, Reset>::set_external_vsl(const uint8_t v) {
+    // 0xB4 = command for vsl
+    // 0b00 = External VSL [reset]
+    // 0b01, 0b10, 0b11 = invalid    
+    write_command(0xB4);
+
+    uint8_t tmp[] = {uint8_t(0xA0 | (v & 0x03)), 0xB5, 0x55};
+    write_data(tmp, sizeof(tmp));
+}
+
+template <typename Bus, typename Dc, typename Cs, typename Reset>
+void ssd1351_t<Bus, Dc, Cs, Reset>::set_com_deselect_voltage(const uint8_t voltage) {
+    // 0xBE = com deselect voltage command
+    // 0b000 = 0x00 = 0.72 x VCC\n
+    // 0b101 = 0x05 = 0.82 x VCC [reset]\n
+    // 0b111 = 0x07 = 0.86 x VCC\n
+    write_command(0xBE);
+    
+    // write the voltage
+    write_data(voltage & 0x07);
+}
+
+template <typename Bus, typename Dc, typename Cs, typename Reset>
+void ssd1351_t<Bus, Dc, Cs, Reset>::set_second_precharge(const uint8_t precharge) {
+    // 0xB6 = second pre-charge period command
+    // 0b0000 = invalid\n
+    // 0b0001 = 1 DCLKS\n
+    // 0b0010 = 2 DCLKS\n
+    // 0b1111 = 15 DCLKS\n    
+    write_command(0xB6);
+
+    // write precharge
+    write_data(precharge & 0x0F);
+}
+
+/**
+ * @brief SSD1351 Library with a runtime spi bus and runtime pins
+ * 
+ * @details Works with every hwlib pin and every spi_bus_extended
+ * 
+ */
+class ssd1351 : public ssd1351_t<spi_bus_extended, hwlib::pin_out, hwlib::pin_out, hwlib::pin_out> {
+    public:
+        /**
+         * @brief Construct a new ssd1351 object
+         * 
+         * @param spi the spi bus
+         * @param reset the reset pin
+         * @param dc the data/command pin
+         * @param cs the chip select pin
+         */
+        ssd1351(spi_bus_extended &spi, hwlib::pin_out &reset, 
+                hwlib::pin_out &dc, hwlib::pin_out &cs):
+            ssd1351_t(spi, reset, dc, cs)
+        {}
+};
+
+// the runtime driver is compiled once in ssd1351.cpp
+extern template class ssd1351_t<spi_bus_extended, hwlib::pin_out, hwlib::pin_out, hwlib::pin_out>;
+
+#endif